@@ -0,0 +1,356 @@
+/*
+ * Native GATT notification forwarding for the BLE bridge
+ *
+ * firmware/ble_bridge.py used to run one Python loop per subscribed
+ * characteristic, each awaiting aioble's notified() and waking once per
+ * notification.  Here a NimBLE GAP event listener copies every notification
+ * for a subscribed (connection, value handle) pair into a preallocated
+ * single-producer/single-consumer ring, stamped with esp_timer at arrival,
+ * and wakes Python through one scheduled callback per batch.  A single
+ * Python task then drains everything that arrived since it last ran.
+ *
+ * aioble still sees the notifications (the listener only observes), so its
+ * characteristic objects keep working for reads and writes.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "py/mphal.h"
+
+#if MICROPY_PY_BLUETOOTH && MICROPY_BLUETOOTH_NIMBLE
+
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "host/ble_gap.h"
+#include "host/ble_hs.h"
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Subscriptions                                                            */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+#define BLE_NOTIFY_MAX_SUBS 8
+
+typedef struct {
+    uint16_t conn_handle;
+    uint16_t value_handle;
+    bool used;
+} ble_notify_sub_t;
+
+static ble_notify_sub_t ble_notify_subs[BLE_NOTIFY_MAX_SUBS];
+static portMUX_TYPE ble_notify_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Subscription index for a notification, -1 if nobody asked for it (lock held) */
+static int ble_notify_sub_index(uint16_t conn_handle, uint16_t value_handle) {
+    for (int i = 0; i < BLE_NOTIFY_MAX_SUBS; i++) {
+        const ble_notify_sub_t *s = &ble_notify_subs[i];
+        if (s->used && s->conn_handle == conn_handle && s->value_handle == value_handle) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int ble_notify_sub_find(uint16_t conn_handle, uint16_t value_handle) {
+    taskENTER_CRITICAL(&ble_notify_lock);
+    int found = ble_notify_sub_index(conn_handle, value_handle);
+    taskEXIT_CRITICAL(&ble_notify_lock);
+    return found;
+}
+
+/* Forget every subscription on conn_handle, e.g. once it disconnects */
+static void ble_notify_sub_drop_conn(uint16_t conn_handle) {
+    taskENTER_CRITICAL(&ble_notify_lock);
+    for (int i = 0; i < BLE_NOTIFY_MAX_SUBS; i++) {
+        if (ble_notify_subs[i].conn_handle == conn_handle) {
+            ble_notify_subs[i].used = false;
+        }
+    }
+    taskEXIT_CRITICAL(&ble_notify_lock);
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Notification ring                                                        */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * Same scheme as the ble_scan result ring: the NimBLE host task writes head,
+ * MicroPython writes tail, no locks.  Scale notifications are a few bytes;
+ * anything longer than BLE_NOTIFY_DATA_MAX is cut and flagged.
+ */
+#define BLE_NOTIFY_DATA_MAX 48
+
+typedef struct {
+    uint32_t t_us;                  /* esp_timer at arrival, low 32 bits */
+    uint8_t sub;
+    uint8_t len;
+    uint8_t truncated;
+    uint8_t reserved;
+    uint8_t data[BLE_NOTIFY_DATA_MAX];
+} ble_notify_record_t;
+
+typedef struct {
+    ble_notify_record_t *records;   /* outside the GC heap */
+    uint32_t capacity;              /* power of two */
+    volatile uint32_t head;         /* producer */
+    volatile uint32_t tail;         /* consumer */
+    volatile uint32_t received;
+    volatile uint32_t dropped;
+    volatile uint32_t truncated;
+    volatile bool wake_pending;     /* a wake callback is scheduled, not yet drained */
+    volatile uint32_t writers;      /* listener callbacks writing into records */
+    /* Queueing latency, arrival to drain(), accounted on the consumer side */
+    uint32_t drained;
+    uint64_t latency_sum_us;
+    uint32_t latency_max_us;
+} ble_notify_ring_t;
+
+static ble_notify_ring_t ble_notify_ring;
+static struct ble_gap_event_listener ble_notify_listener;
+
+MP_REGISTER_ROOT_POINTER(mp_obj_t ble_notify_wake);
+
+/* Producer side: queue one notification; false if the ring is full */
+static bool ble_notify_ring_put(ble_notify_ring_t *ring, int sub, struct os_mbuf *om, uint32_t now) {
+    ring->received++;
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= ring->capacity) {
+        ring->dropped++;
+        return false;
+    }
+    ble_notify_record_t *r = &ring->records[head & (ring->capacity - 1)];
+    uint16_t len = OS_MBUF_PKTLEN(om);
+    r->t_us = now;
+    r->sub = sub;
+    r->truncated = len > BLE_NOTIFY_DATA_MAX;
+    r->len = r->truncated ? BLE_NOTIFY_DATA_MAX : len;
+    os_mbuf_copydata(om, 0, r->len, r->data);
+    if (r->truncated) ring->truncated++;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static int ble_notify_gap_cb(struct ble_gap_event *event, void *arg) {
+    ble_notify_ring_t *ring = &ble_notify_ring;
+    switch (event->type) {
+        case BLE_GAP_EVENT_NOTIFY_RX: {
+            /* Registered as a writer under the lock: start() waits for
+             * writers to leave before it frees the records */
+            taskENTER_CRITICAL(&ble_notify_lock);
+            int sub = ble_notify_sub_index(event->notify_rx.conn_handle, event->notify_rx.attr_handle);
+            if (sub >= 0 && ring->records != NULL) {
+                __atomic_add_fetch(&ring->writers, 1, __ATOMIC_ACQUIRE);
+            } else {
+                sub = -1;
+            }
+            taskEXIT_CRITICAL(&ble_notify_lock);
+            if (sub < 0) {
+                return 0;
+            }
+            uint32_t now = (uint32_t)esp_timer_get_time();
+            bool queued = ble_notify_ring_put(ring, sub, event->notify_rx.om, now);
+            __atomic_sub_fetch(&ring->writers, 1, __ATOMIC_RELEASE);
+
+            /* One wake per batch: drain() clears wake_pending before reading */
+            if (queued && !__atomic_exchange_n(&ring->wake_pending, true, __ATOMIC_ACQ_REL)) {
+                mp_obj_t wake = MP_STATE_PORT(ble_notify_wake);
+                if (wake == MP_OBJ_NULL || !mp_sched_schedule(wake, mp_const_none)) {
+                    ring->wake_pending = false;
+                }
+            }
+            return 0;
+        }
+        case BLE_GAP_EVENT_DISCONNECT:
+            ble_notify_sub_drop_conn(event->disconnect.conn.conn_handle);
+            return 0;
+    }
+    return 0;
+}
+
+/*
+ * start(wake, capacity=32) — allocate the ring and start listening.  wake is
+ * called as wake(None) through micropython.schedule() whenever
+ * notifications are waiting, e.g. lambda _: flag.set() for an asyncio
+ * ThreadSafeFlag.
+ */
+static mp_obj_t ble_notify_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_wake, ARG_capacity };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_wake,     MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_capacity, MP_ARG_INT, {.u_int = 32} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (!mp_obj_is_callable(args[ARG_wake].u_obj)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("wake must be callable"));
+    }
+    mp_int_t want = args[ARG_capacity].u_int;
+    if (want < 1 || want > 1024) {
+        mp_raise_ValueError(MP_ERROR_TEXT("capacity must be 1..1024"));
+    }
+    uint32_t capacity = 1;
+    while (capacity < (uint32_t)want) capacity <<= 1;
+
+    ble_notify_ring_t *ring = &ble_notify_ring;
+    if (ring->records == NULL || ring->capacity != capacity) {
+        /* Nothing may write into the old ring while it is replaced: no new
+         * writer gets in once records is NULL, then wait out the current one */
+        taskENTER_CRITICAL(&ble_notify_lock);
+        memset(ble_notify_subs, 0, sizeof(ble_notify_subs));
+        ble_notify_record_t *old = ring->records;
+        ring->records = NULL;
+        taskEXIT_CRITICAL(&ble_notify_lock);
+        while (__atomic_load_n(&ring->writers, __ATOMIC_ACQUIRE) != 0) {
+            vTaskDelay(1);
+        }
+        heap_caps_free(old);
+        ble_notify_record_t *records = heap_caps_malloc((size_t)capacity * sizeof(ble_notify_record_t),
+                                                        MALLOC_CAP_8BIT);
+        if (records == NULL) {
+            ring->capacity = 0;
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no memory for notify ring"));
+        }
+        ring->capacity = capacity;
+        ring->head = ring->tail = 0;
+        __atomic_store_n(&ring->records, records, __ATOMIC_RELEASE);
+    }
+    ring->received = ring->dropped = ring->truncated = 0;
+    ring->drained = 0;
+    ring->latency_sum_us = 0;
+    ring->latency_max_us = 0;
+    MP_STATE_PORT(ble_notify_wake) = args[ARG_wake].u_obj;
+
+    /* Already registered unless the NimBLE host was restarted in between */
+    int rc = ble_gap_event_listener_register(&ble_notify_listener, ble_notify_gap_cb, NULL);
+    if (rc != 0 && rc != BLE_HS_EALREADY) {
+        mp_raise_OSError(rc);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(ble_notify_start_obj, 1, ble_notify_start);
+
+/*
+ * subscribe(conn_handle, value_handle) — forward notifications of one
+ * characteristic; returns the id drain() reports them under.  The CCCD is
+ * not written here, that stays with the caller.
+ */
+static mp_obj_t ble_notify_subscribe(mp_obj_t conn_in, mp_obj_t value_in) {
+    mp_int_t conn_handle = mp_obj_get_int(conn_in);
+    mp_int_t value_handle = mp_obj_get_int(value_in);
+    int existing = ble_notify_sub_find(conn_handle, value_handle);
+    if (existing >= 0) {
+        return MP_OBJ_NEW_SMALL_INT(existing);
+    }
+    int id = -1;
+    taskENTER_CRITICAL(&ble_notify_lock);
+    for (int i = 0; i < BLE_NOTIFY_MAX_SUBS; i++) {
+        ble_notify_sub_t *s = &ble_notify_subs[i];
+        if (!s->used) {
+            s->conn_handle = conn_handle;
+            s->value_handle = value_handle;
+            s->used = true;
+            id = i;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&ble_notify_lock);
+    if (id < 0) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("too many notify subscriptions"));
+    }
+    return MP_OBJ_NEW_SMALL_INT(id);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(ble_notify_subscribe_obj, ble_notify_subscribe);
+
+/* stop() — drop all subscriptions and anything still queued */
+static mp_obj_t ble_notify_stop(void) {
+    ble_notify_ring_t *ring = &ble_notify_ring;
+    taskENTER_CRITICAL(&ble_notify_lock);
+    memset(ble_notify_subs, 0, sizeof(ble_notify_subs));
+    taskEXIT_CRITICAL(&ble_notify_lock);
+    __atomic_store_n(&ring->tail, __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+    ring->wake_pending = false;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_notify_stop_obj, ble_notify_stop);
+
+/*
+ * drain() — list of (id, ticks_us, data) for every queued notification,
+ * oldest first.  ticks_us is comparable with time.ticks_us().
+ */
+static mp_obj_t ble_notify_drain(void) {
+    ble_notify_ring_t *ring = &ble_notify_ring;
+    /* Clear first: a notification landing after this schedules a new wake */
+    __atomic_store_n(&ring->wake_pending, false, __ATOMIC_RELEASE);
+
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    if (ring->records == NULL) return list;
+
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    for (; tail != head; tail++) {
+        const ble_notify_record_t *r = &ring->records[tail & (ring->capacity - 1)];
+        uint32_t latency = now - r->t_us;
+        ring->latency_sum_us += latency;
+        if (latency > ring->latency_max_us) ring->latency_max_us = latency;
+        ring->drained++;
+        mp_obj_t item[3] = {
+            MP_OBJ_NEW_SMALL_INT(r->sub),
+            MP_OBJ_NEW_SMALL_INT(r->t_us & MP_SMALL_INT_POSITIVE_MASK),
+            mp_obj_new_bytes(r->data, r->len),
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(3, item));
+        /* The allocations above can run the GC: free the slot as we go */
+        __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    }
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_notify_drain_obj, ble_notify_drain);
+
+/* info() — counters and arrival-to-drain latency since start() */
+static mp_obj_t ble_notify_info(void) {
+    ble_notify_ring_t *ring = &ble_notify_ring;
+    mp_obj_t dict = mp_obj_new_dict(8);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_capacity), mp_obj_new_int_from_uint(ring->capacity));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_pending), mp_obj_new_int_from_uint(ring->head - ring->tail));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_received), mp_obj_new_int_from_uint(ring->received));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_dropped), mp_obj_new_int_from_uint(ring->dropped));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_truncated), mp_obj_new_int_from_uint(ring->truncated));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_drained), mp_obj_new_int_from_uint(ring->drained));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_latency_avg_us),
+                      mp_obj_new_int_from_uint(ring->drained ? ring->latency_sum_us / ring->drained : 0));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_latency_max_us), mp_obj_new_int_from_uint(ring->latency_max_us));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_notify_info_obj, ble_notify_info);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Module registration                                                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+static const mp_rom_map_elem_t ble_notify_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__),  MP_ROM_QSTR(MP_QSTR_ble_notify) },
+    { MP_ROM_QSTR(MP_QSTR_start),     MP_ROM_PTR(&ble_notify_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_subscribe), MP_ROM_PTR(&ble_notify_subscribe_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop),      MP_ROM_PTR(&ble_notify_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_drain),     MP_ROM_PTR(&ble_notify_drain_obj) },
+    { MP_ROM_QSTR(MP_QSTR_info),      MP_ROM_PTR(&ble_notify_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_DATA_MAX),  MP_ROM_INT(BLE_NOTIFY_DATA_MAX) },
+};
+static MP_DEFINE_CONST_DICT(ble_notify_module_globals, ble_notify_module_globals_table);
+
+const mp_obj_module_t ble_notify_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&ble_notify_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_ble_notify, ble_notify_module);
+
+#endif /* MICROPY_PY_BLUETOOTH && MICROPY_BLUETOOTH_NIMBLE */
@@ -0,0 +1,22 @@
+# Native GATT notification forwarding for firmware/ble_bridge.py
+# Include this alongside rgb_panel_lvgl in USER_C_MODULES
+
+add_library(usermod_ble_notify INTERFACE)
+
+target_sources(usermod_ble_notify INTERFACE
+    ${CMAKE_CURRENT_LIST_DIR}/ble_notify.c
+)
+
+target_include_directories(usermod_ble_notify INTERFACE
+    ${CMAKE_CURRENT_LIST_DIR}
+)
+
+# NimBLE host headers for the GAP event listener
+if(IDF_TARGET)
+    target_link_libraries(usermod_ble_notify INTERFACE
+        idf::bt
+        idf::heap
+    )
+endif()
+
+target_link_libraries(usermod INTERFACE usermod_ble_notify)
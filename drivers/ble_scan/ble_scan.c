@@ -0,0 +1,1074 @@
+/*
+ * Native BLE advertisement parsing for the scan bridge
+ *
+ * Replaces _parse_raw_entry()/_merge_entry() in firmware/ble_bridge.py for
+ * boards built with this module.  The AD structures are walked in place,
+ * without slicing, and a dict is only built for a device seen for the first
+ * time; repeat advertisements update the existing entry and allocate
+ * nothing unless they carry a field the entry was missing.
+ *
+ * On NimBLE builds the module can also run the scan itself: results land in
+ * a preallocated ring of packed records and are merged from there into a
+ * native device table, so a steady-state scan allocates nothing per
+ * advertisement.
+ *
+ * Produces exactly the dict shape of the Python parser:
+ *   {"address": "AA:BB:..", "name": str, "rssi": int, "services": [str],
+ *    "addr_type": int[, "manufacturer_id": int, "manufacturer_data": hex]}
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/objstr.h"
+#include "py/qstr.h"
+#include "py/runtime.h"
+#include "py/mphal.h"
+
+#if MICROPY_PY_BLUETOOTH && MICROPY_BLUETOOTH_NIMBLE
+#include <stdlib.h>
+
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "host/ble_gap.h"
+#include "host/ble_hs.h"
+#endif
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Advertisement parsing                                                    */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+#define BLE_SCAN_AD_NAME_SHORT          0x08
+#define BLE_SCAN_AD_NAME_COMPLETE       0x09
+#define BLE_SCAN_AD_UUID16_INCOMPLETE   0x02
+#define BLE_SCAN_AD_UUID16_COMPLETE     0x03
+#define BLE_SCAN_AD_MANUFACTURER        0xFF
+
+#define BLE_SCAN_MAX_UUID16_FIELDS      4   /* AD structures with 16-bit UUIDs */
+#define BLE_SCAN_MAX_UUID16             14  /* as many as fit in a 31-byte payload */
+
+/* Fields of one advertisement, pointing into the raw payload */
+typedef struct {
+    const uint8_t *name;
+    size_t name_len;
+    const uint8_t *uuid16[BLE_SCAN_MAX_UUID16_FIELDS];
+    uint8_t uuid16_len[BLE_SCAN_MAX_UUID16_FIELDS];
+    uint8_t uuid16_fields;
+    const uint8_t *mfr;             /* company ID + data, NULL if absent */
+    size_t mfr_len;
+} ble_scan_adv_t;
+
+/* Same walk as the Python parser: the last name / manufacturer field wins */
+static void ble_scan_parse_adv(const uint8_t *raw, size_t len, ble_scan_adv_t *adv) {
+    memset(adv, 0, sizeof(*adv));
+    size_t i = 0;
+    while (i < len) {
+        uint8_t length = raw[i];
+        if (length == 0 || i + 1 >= len) break;
+        uint8_t type = raw[i + 1];
+        size_t end = i + 1 + length;
+        if (end > len) end = len;
+        const uint8_t *payload = raw + i + 2;
+        size_t payload_len = end - (i + 2);
+
+        switch (type) {
+            case BLE_SCAN_AD_NAME_COMPLETE:
+            case BLE_SCAN_AD_NAME_SHORT:
+                adv->name = payload;
+                adv->name_len = payload_len;
+                break;
+            case BLE_SCAN_AD_UUID16_COMPLETE:
+            case BLE_SCAN_AD_UUID16_INCOMPLETE:
+                if (adv->uuid16_fields < BLE_SCAN_MAX_UUID16_FIELDS) {
+                    adv->uuid16[adv->uuid16_fields] = payload;
+                    adv->uuid16_len[adv->uuid16_fields] = payload_len;
+                    adv->uuid16_fields++;
+                }
+                break;
+            case BLE_SCAN_AD_MANUFACTURER:
+                /* The field may be cut short by the end of the advert */
+                if (length >= 3 && payload_len >= 2) {
+                    adv->mfr = payload;
+                    adv->mfr_len = payload_len;
+                }
+                break;
+        }
+        i += (size_t)length + 1;
+    }
+}
+
+/* Flatten the 16-bit service UUIDs into out[BLE_SCAN_MAX_UUID16] */
+static size_t ble_scan_adv_uuids(const ble_scan_adv_t *adv, uint16_t *out) {
+    size_t n = 0;
+    for (uint8_t f = 0; f < adv->uuid16_fields; f++) {
+        const uint8_t *p = adv->uuid16[f];
+        for (size_t j = 0; j + 1 < adv->uuid16_len[f] && n < BLE_SCAN_MAX_UUID16; j += 2) {
+            out[n++] = p[j] | (p[j + 1] << 8);
+        }
+    }
+    return n;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Object construction                                                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+static const char ble_scan_hex[] = "0123456789abcdef";
+
+static mp_obj_t ble_scan_mac_str(const uint8_t *addr) {
+    static const char upper[] = "0123456789ABCDEF";
+    char buf[17];
+    for (int i = 0; i < 6; i++) {
+        buf[i * 3] = upper[addr[i] >> 4];
+        buf[i * 3 + 1] = upper[addr[i] & 0x0F];
+        if (i < 5) buf[i * 3 + 2] = ':';
+    }
+    return mp_obj_new_str(buf, sizeof(buf));
+}
+
+static bool ble_scan_name_valid(const uint8_t *name, size_t len) {
+    #if MICROPY_PY_BUILTINS_STR_UNICODE_CHECK
+    return utf8_check(name, len);
+    #else
+    return true;
+    #endif
+}
+
+/* Invalid UTF-8 leaves the name empty, like the Python decode() fallback */
+static mp_obj_t ble_scan_name_str(const uint8_t *name, size_t len) {
+    if (name == NULL || len == 0 || !ble_scan_name_valid(name, len)) {
+        return MP_OBJ_NEW_QSTR(MP_QSTR_);
+    }
+    return mp_obj_new_str((const char *)name, len);
+}
+
+static mp_obj_t ble_scan_hex_str(const uint8_t *data, size_t len) {
+    vstr_t vstr;
+    vstr_init_len(&vstr, len * 2);
+    for (size_t i = 0; i < len; i++) {
+        vstr.buf[i * 2] = ble_scan_hex[data[i] >> 4];
+        vstr.buf[i * 2 + 1] = ble_scan_hex[data[i] & 0x0F];
+    }
+    return mp_obj_new_str_from_vstr(&vstr);
+}
+
+static mp_obj_t ble_scan_services_list(const uint16_t *uuids, size_t count) {
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (size_t i = 0; i < count; i++) {
+        uint16_t uuid = uuids[i];
+        char buf[4] = {
+            ble_scan_hex[(uuid >> 12) & 0x0F], ble_scan_hex[(uuid >> 8) & 0x0F],
+            ble_scan_hex[(uuid >> 4) & 0x0F], ble_scan_hex[uuid & 0x0F],
+        };
+        mp_obj_list_append(list, mp_obj_new_str(buf, sizeof(buf)));
+    }
+    return list;
+}
+
+/* mfr is company ID + data; shorter than the company ID stores nothing */
+static void ble_scan_store_mfr(mp_obj_t dict, const uint8_t *mfr, size_t len) {
+    if (len < 2) return;
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_manufacturer_id),
+                      MP_OBJ_NEW_SMALL_INT(mfr[0] | (mfr[1] << 8)));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_manufacturer_data),
+                      ble_scan_hex_str(mfr + 2, len - 2));
+}
+
+/* One device dict; mfr may be NULL */
+static mp_obj_t ble_scan_entry_dict(const uint8_t *addr, mp_int_t addr_type, mp_int_t rssi,
+                                    const uint8_t *name, size_t name_len,
+                                    const uint16_t *uuids, size_t uuid_count,
+                                    const uint8_t *mfr, size_t mfr_len) {
+    mp_obj_t dict = mp_obj_new_dict(mfr ? 7 : 5);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_address), ble_scan_mac_str(addr));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_name), ble_scan_name_str(name, name_len));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_rssi), MP_OBJ_NEW_SMALL_INT(rssi));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_services), ble_scan_services_list(uuids, uuid_count));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_addr_type), MP_OBJ_NEW_SMALL_INT(addr_type));
+    if (mfr != NULL) {
+        ble_scan_store_mfr(dict, mfr, mfr_len);
+    }
+    return dict;
+}
+
+static mp_obj_t ble_scan_new_entry(const uint8_t *addr, mp_int_t addr_type, mp_int_t rssi,
+                                   const ble_scan_adv_t *adv) {
+    uint16_t uuids[BLE_SCAN_MAX_UUID16];
+    size_t n = ble_scan_adv_uuids(adv, uuids);
+    return ble_scan_entry_dict(addr, addr_type, rssi, adv->name, adv->name_len,
+                               uuids, n, adv->mfr, adv->mfr_len);
+}
+
+static const uint8_t *ble_scan_get_addr(mp_obj_t addr_in) {
+    mp_buffer_info_t addr;
+    mp_get_buffer_raise(addr_in, &addr, MP_BUFFER_READ);
+    if (addr.len != 6) {
+        mp_raise_ValueError(MP_ERROR_TEXT("address must be 6 bytes"));
+    }
+    return addr.buf;
+}
+
+/*
+ * Merge one advertisement into seen.  key is the dict key for addr; when it
+ * is MP_OBJ_NULL a bytes key is only allocated if the address is new.
+ * Returns true if a new entry was added.
+ */
+static bool ble_scan_merge_adv(mp_obj_t seen_in, mp_obj_t key, const uint8_t *addr,
+                               mp_int_t addr_type, mp_int_t rssi, const uint8_t *raw, size_t len) {
+    mp_obj_dict_t *seen = MP_OBJ_TO_PTR(seen_in);
+    ble_scan_adv_t adv;
+    ble_scan_parse_adv(raw, len, &adv);
+
+    mp_map_elem_t *elem;
+    if (key != MP_OBJ_NULL) {
+        elem = mp_map_lookup(&seen->map, key, MP_MAP_LOOKUP);
+    } else {
+        /* Look up with a stack bytes object; only a new entry needs a real one */
+        mp_obj_str_t tmp = {{&mp_type_bytes}, qstr_compute_hash(addr, 6), 6, addr};
+        elem = mp_map_lookup(&seen->map, MP_OBJ_FROM_PTR(&tmp), MP_MAP_LOOKUP);
+    }
+    if (elem == NULL) {
+        if (key == MP_OBJ_NULL) {
+            key = mp_obj_new_bytes(addr, 6);
+        }
+        mp_obj_dict_store(seen_in, key, ble_scan_new_entry(addr, addr_type, rssi, &adv));
+        return true;
+    }
+
+    mp_obj_t entry = elem->value;
+    mp_map_t *map = mp_obj_dict_get_map(entry);
+    mp_map_elem_t *f = mp_map_lookup(map, MP_OBJ_NEW_QSTR(MP_QSTR_rssi), MP_MAP_LOOKUP);
+    if (f != NULL && rssi > mp_obj_get_int(f->value)) {
+        f->value = MP_OBJ_NEW_SMALL_INT(rssi);
+    }
+    if (adv.name_len > 0) {
+        f = mp_map_lookup(map, MP_OBJ_NEW_QSTR(MP_QSTR_name), MP_MAP_LOOKUP);
+        if (f != NULL && !mp_obj_is_true(f->value)) {
+            f->value = ble_scan_name_str(adv.name, adv.name_len);
+        }
+    }
+    if (adv.mfr != NULL && adv.mfr_len > 2) {
+        f = mp_map_lookup(map, MP_OBJ_NEW_QSTR(MP_QSTR_manufacturer_data), MP_MAP_LOOKUP);
+        if (f == NULL || !mp_obj_is_true(f->value)) {
+            ble_scan_store_mfr(entry, adv.mfr, adv.mfr_len);
+        }
+    }
+    return false;
+}
+
+#if MICROPY_PY_BLUETOOTH && MICROPY_BLUETOOTH_NIMBLE
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Device table                                                             */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * Replaces the Python _seen dict for the native scan path: open addressing
+ * with linear probing over the 6-byte address, slots in PSRAM, sized to
+ * twice the device limit.  Devices not heard from for ttl_ms are evicted
+ * (backward-shift deletion, no tombstones) when results are collected,
+ * instead of the whole table being dropped every few cycles.
+ *
+ * rssi is reported per results() period: the strongest advertisement since
+ * the previous call, or the last reported value if the device was silent.
+ */
+#define BLE_SCAN_NAME_MAX 29        /* 31-byte payload minus one AD header */
+#define BLE_SCAN_MFR_MAX  29
+
+typedef struct {
+    uint8_t addr[6];
+    uint8_t addr_type;
+    uint8_t used;
+    int8_t rssi;                    /* reported */
+    int8_t rssi_period;             /* strongest since results(), INT8_MIN = none */
+    uint8_t name_len;
+    uint8_t mfr_len;                /* company ID + data */
+    uint8_t uuid_count;
+    uint32_t first_ms;
+    uint32_t last_ms;
+    uint8_t name[BLE_SCAN_NAME_MAX];
+    uint8_t mfr[BLE_SCAN_MFR_MAX];
+    uint16_t uuids[BLE_SCAN_MAX_UUID16];
+} ble_scan_dev_t;
+
+typedef struct {
+    ble_scan_dev_t *slots;
+    uint32_t capacity;              /* power of two */
+    uint32_t max_devices;
+    uint32_t count;
+    uint32_t ttl_ms;
+    uint32_t evicted;
+    uint32_t refused;               /* new devices turned away while full */
+} ble_scan_table_t;
+
+static ble_scan_table_t ble_scan_table;
+
+/* "AA:BB:CC:DD:EE:FF" or a 6-byte buffer */
+static void ble_scan_get_mac(mp_obj_t obj, uint8_t *out) {
+    if (!mp_obj_is_str(obj)) {
+        memcpy(out, ble_scan_get_addr(obj), 6);
+        return;
+    }
+    size_t len;
+    const char *str = mp_obj_str_get_data(obj, &len);
+    if (len != 17) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bad MAC address"));
+    }
+    for (int i = 0; i < 6; i++) {
+        uint8_t v = 0;
+        for (int k = 0; k < 2; k++) {
+            char c = str[i * 3 + k];
+            v <<= 4;
+            if (c >= '0' && c <= '9') v |= c - '0';
+            else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+            else mp_raise_ValueError(MP_ERROR_TEXT("bad MAC address"));
+        }
+        out[i] = v;
+    }
+}
+
+static inline uint32_t ble_scan_addr_hash(const uint8_t *addr) {
+    uint32_t h = 2166136261u;       /* FNV-1a */
+    for (int i = 0; i < 6; i++) {
+        h = (h ^ addr[i]) * 16777619u;
+    }
+    return h;
+}
+
+/* With added != NULL, insert the address if missing and say whether it was */
+static ble_scan_dev_t *ble_scan_table_find(ble_scan_table_t *t, const uint8_t *addr, bool *added) {
+    uint32_t mask = t->capacity - 1;
+    uint32_t i = ble_scan_addr_hash(addr) & mask;
+    while (t->slots[i].used) {
+        if (memcmp(t->slots[i].addr, addr, 6) == 0) {
+            return &t->slots[i];
+        }
+        i = (i + 1) & mask;
+    }
+    if (added == NULL) return NULL;
+    if (t->count >= t->max_devices) {
+        t->refused++;
+        return NULL;
+    }
+    ble_scan_dev_t *d = &t->slots[i];
+    memset(d, 0, sizeof(*d));
+    memcpy(d->addr, addr, 6);
+    d->used = 1;
+    d->rssi_period = INT8_MIN;
+    t->count++;
+    *added = true;
+    return d;
+}
+
+/* Remove slot i, shifting later members of its probe run back into the gap */
+static void ble_scan_table_remove(ble_scan_table_t *t, uint32_t i) {
+    uint32_t mask = t->capacity - 1;
+    uint32_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!t->slots[j].used) break;
+        uint32_t home = ble_scan_addr_hash(t->slots[j].addr) & mask;
+        /* Move j into the gap unless its home lies cyclically in (i, j] */
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            t->slots[i] = t->slots[j];
+            i = j;
+        }
+    }
+    t->slots[i].used = 0;
+    t->count--;
+}
+
+static void ble_scan_table_update(ble_scan_table_t *t, const uint8_t *addr, uint8_t addr_type,
+                                  int8_t rssi, const uint8_t *raw, size_t len, uint32_t now) {
+    bool added = false;
+    ble_scan_dev_t *d = ble_scan_table_find(t, addr, &added);
+    if (d == NULL) return;
+
+    ble_scan_adv_t adv;
+    ble_scan_parse_adv(raw, len, &adv);
+    if (added) {
+        d->first_ms = now;
+        d->rssi = rssi;
+    }
+    d->addr_type = addr_type;
+    d->last_ms = now;
+    if (rssi > d->rssi_period) d->rssi_period = rssi;
+
+    /* First name / manufacturer data / service list seen is kept */
+    if (d->name_len == 0 && adv.name_len > 0 && adv.name_len <= BLE_SCAN_NAME_MAX &&
+        ble_scan_name_valid(adv.name, adv.name_len)) {
+        memcpy(d->name, adv.name, adv.name_len);
+        d->name_len = adv.name_len;
+    }
+    if (adv.mfr != NULL && d->mfr_len <= 2 && adv.mfr_len > d->mfr_len &&
+        adv.mfr_len <= BLE_SCAN_MFR_MAX) {
+        memcpy(d->mfr, adv.mfr, adv.mfr_len);
+        d->mfr_len = adv.mfr_len;
+    }
+    if (d->uuid_count == 0) {
+        d->uuid_count = ble_scan_adv_uuids(&adv, d->uuids);
+    }
+}
+
+/* Evict devices silent for longer than ttl_ms */
+static void ble_scan_table_age(ble_scan_table_t *t, uint32_t now) {
+    for (uint32_t i = 0; i < t->capacity; i++) {
+        /* A removal can shift another device into slot i: look again */
+        while (t->slots[i].used && now - t->slots[i].last_ms > t->ttl_ms) {
+            ble_scan_table_remove(t, i);
+            t->evicted++;
+        }
+    }
+}
+
+/*
+ * table(max_devices, ttl_ms) — (re)allocate the device table, empty.  Must
+ * be called before drain() without arguments.
+ */
+static mp_obj_t ble_scan_table_setup(mp_obj_t max_in, mp_obj_t ttl_in) {
+    ble_scan_table_t *t = &ble_scan_table;
+    mp_int_t max_devices = mp_obj_get_int(max_in);
+    mp_int_t ttl_ms = mp_obj_get_int(ttl_in);
+    if (max_devices < 1 || max_devices > 32768) {
+        mp_raise_ValueError(MP_ERROR_TEXT("max_devices must be 1..32768"));
+    }
+    if (ttl_ms < 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ttl_ms must be positive"));
+    }
+    uint32_t capacity = 1;
+    while (capacity < 2 * (uint32_t)max_devices) capacity <<= 1;
+
+    if (t->slots == NULL || t->capacity != capacity) {
+        heap_caps_free(t->slots);
+        size_t size = (size_t)capacity * sizeof(ble_scan_dev_t);
+        t->slots = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+        if (t->slots == NULL) {
+            t->slots = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+        }
+        if (t->slots == NULL) {
+            t->capacity = 0;
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no memory for device table"));
+        }
+        t->capacity = capacity;
+    }
+    memset(t->slots, 0, (size_t)capacity * sizeof(ble_scan_dev_t));
+    t->max_devices = max_devices;
+    t->ttl_ms = ttl_ms;
+    t->count = 0;
+    t->evicted = 0;
+    t->refused = 0;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(ble_scan_table_obj, ble_scan_table_setup);
+
+/* Only devices with a name or manufacturer data are reported */
+static inline bool ble_scan_dev_reported(const ble_scan_dev_t *d) {
+    return d->used && (d->name_len > 0 || d->mfr_len > 2);
+}
+
+/* Age out silent devices and start a new RSSI period; returns how many to report */
+static uint32_t ble_scan_table_collect(ble_scan_table_t *t) {
+    uint32_t count = 0;
+    ble_scan_table_age(t, mp_hal_ticks_ms());
+    for (uint32_t i = 0; i < t->capacity; i++) {
+        ble_scan_dev_t *d = &t->slots[i];
+        if (!d->used) continue;
+        if (d->rssi_period != INT8_MIN) {
+            d->rssi = d->rssi_period;
+            d->rssi_period = INT8_MIN;
+        }
+        if (ble_scan_dev_reported(d)) count++;
+    }
+    return count;
+}
+
+/*
+ * results() — age out silent devices and return the rest that have a name
+ * or manufacturer data, as device dicts.  Starts a new RSSI period.
+ */
+static mp_obj_t ble_scan_results(void) {
+    ble_scan_table_t *t = &ble_scan_table;
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    if (t->slots == NULL) return list;
+
+    ble_scan_table_collect(t);
+    for (uint32_t i = 0; i < t->capacity; i++) {
+        ble_scan_dev_t *d = &t->slots[i];
+        if (!ble_scan_dev_reported(d)) continue;
+        mp_obj_list_append(list, ble_scan_entry_dict(d->addr, d->addr_type, d->rssi,
+                                                     d->name, d->name_len, d->uuids, d->uuid_count,
+                                                     d->mfr_len >= 2 ? d->mfr : NULL, d->mfr_len));
+    }
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_scan_results_obj, ble_scan_results);
+
+/*
+ * The same list as results(), packed for the scan/results topic when the
+ * host asked for it (see src/ble/handler-mqtt-proxy.ts).  Little-endian:
+ *
+ *   header  "BS" version:u8 reserved:u8 count:u16
+ *   device  addr[6] addr_type:u8 rssi:i8 uuid_count:u8 name_len:u8 mfr_len:u8
+ *           uuids:u16[uuid_count] name[name_len] mfr[mfr_len]
+ *
+ * addr is in display order (the "AA:BB:.." string), mfr is company ID + data
+ * as advertised and mfr_len 0 means no manufacturer data.  Names are valid
+ * UTF-8 (the table only keeps those).
+ */
+#define BLE_SCAN_PACKED_VERSION 1
+#define BLE_SCAN_PACKED_HEADER  6
+#define BLE_SCAN_PACKED_DEVICE  11
+
+static size_t ble_scan_packed_len(const ble_scan_dev_t *d) {
+    size_t mfr_len = d->mfr_len >= 2 ? d->mfr_len : 0;
+    return BLE_SCAN_PACKED_DEVICE + 2 * d->uuid_count + d->name_len + mfr_len;
+}
+
+/* results_packed() — age the table like results() and return the packed bytes */
+static mp_obj_t ble_scan_results_packed(void) {
+    ble_scan_table_t *t = &ble_scan_table;
+    uint32_t count = t->slots != NULL ? ble_scan_table_collect(t) : 0;   /* <= 32768 */
+
+    size_t len = BLE_SCAN_PACKED_HEADER;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < t->capacity && n < count; i++) {
+        if (ble_scan_dev_reported(&t->slots[i])) {
+            len += ble_scan_packed_len(&t->slots[i]);
+            n++;
+        }
+    }
+
+    vstr_t vstr;
+    vstr_init_len(&vstr, len);
+    uint8_t *p = (uint8_t *)vstr.buf;
+    *p++ = 'B';
+    *p++ = 'S';
+    *p++ = BLE_SCAN_PACKED_VERSION;
+    *p++ = 0;
+    *p++ = count & 0xFF;
+    *p++ = count >> 8;
+    n = 0;
+    for (uint32_t i = 0; i < t->capacity && n < count; i++) {
+        const ble_scan_dev_t *d = &t->slots[i];
+        if (!ble_scan_dev_reported(d)) continue;
+        uint8_t mfr_len = d->mfr_len >= 2 ? d->mfr_len : 0;
+        memcpy(p, d->addr, 6);
+        p += 6;
+        *p++ = d->addr_type;
+        *p++ = (uint8_t)d->rssi;
+        *p++ = d->uuid_count;
+        *p++ = d->name_len;
+        *p++ = mfr_len;
+        for (uint8_t k = 0; k < d->uuid_count; k++) {
+            *p++ = d->uuids[k] & 0xFF;
+            *p++ = d->uuids[k] >> 8;
+        }
+        memcpy(p, d->name, d->name_len);
+        p += d->name_len;
+        memcpy(p, d->mfr, mfr_len);
+        p += mfr_len;
+        n++;
+    }
+    return mp_obj_new_bytes_from_vstr(&vstr);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_scan_results_packed_obj, ble_scan_results_packed);
+
+/* seen(mac) — whether the device is in the table, i.e. heard within ttl_ms */
+static mp_obj_t ble_scan_seen(mp_obj_t mac_in) {
+    ble_scan_table_t *t = &ble_scan_table;
+    uint8_t addr[6];
+    ble_scan_get_mac(mac_in, addr);
+    return mp_obj_new_bool(t->slots != NULL && ble_scan_table_find(t, addr, NULL) != NULL);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ble_scan_seen_obj, ble_scan_seen);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Scan filter                                                              */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * Checked in the discovery callback, before a result reaches the ring: an
+ * advertisement passes if its address, one of its 16-bit service UUIDs or
+ * its manufacturer company ID is listed.  Sorted arrays, binary-searched.
+ * With discovery enabled everything passes for window_ms out of every
+ * every_ms, so new devices still show up now and then.  No lists at all
+ * means no filtering.
+ */
+#define BLE_SCAN_FILTER_MACS 64
+#define BLE_SCAN_FILTER_IDS  32
+
+typedef struct {
+    bool enabled;
+    uint8_t mac_count;
+    uint8_t uuid_count;
+    uint8_t mfr_count;
+    uint8_t macs[BLE_SCAN_FILTER_MACS][6];
+    uint16_t uuids[BLE_SCAN_FILTER_IDS];
+    uint16_t mfrs[BLE_SCAN_FILTER_IDS];
+    uint32_t every_ms;              /* discovery period, 0 = off */
+    uint32_t window_ms;
+    uint32_t passed;
+    uint32_t rejected;
+} ble_scan_filter_t;
+
+static ble_scan_filter_t ble_scan_filter;
+static portMUX_TYPE ble_scan_filter_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool ble_scan_u16_find(const uint16_t *sorted, size_t n, uint16_t v) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (sorted[mid] == v) return true;
+        if (sorted[mid] < v) lo = mid + 1; else hi = mid;
+    }
+    return false;
+}
+
+static bool ble_scan_mac_find(const ble_scan_filter_t *f, const uint8_t *addr) {
+    size_t lo = 0, hi = f->mac_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        int c = memcmp(f->macs[mid], addr, 6);
+        if (c == 0) return true;
+        if (c < 0) lo = mid + 1; else hi = mid;
+    }
+    return false;
+}
+
+/* Called on the NimBLE host task for every result; addr is big-endian */
+static bool ble_scan_filter_pass(const uint8_t *addr, const uint8_t *raw, size_t len) {
+    ble_scan_filter_t *f = &ble_scan_filter;
+    bool pass;
+    taskENTER_CRITICAL(&ble_scan_filter_lock);
+    if (!f->enabled) {
+        pass = true;
+    } else if (f->every_ms && (uint32_t)(esp_timer_get_time() / 1000) % f->every_ms < f->window_ms) {
+        pass = true;
+    } else if (ble_scan_mac_find(f, addr)) {
+        pass = true;
+    } else {
+        pass = false;
+        if (f->uuid_count || f->mfr_count) {
+            ble_scan_adv_t adv;
+            ble_scan_parse_adv(raw, len, &adv);
+            if (adv.mfr != NULL && adv.mfr_len >= 2) {
+                pass = ble_scan_u16_find(f->mfrs, f->mfr_count, adv.mfr[0] | (adv.mfr[1] << 8));
+            }
+            if (!pass && f->uuid_count) {
+                uint16_t uuids[BLE_SCAN_MAX_UUID16];
+                size_t n = ble_scan_adv_uuids(&adv, uuids);
+                for (size_t i = 0; i < n && !pass; i++) {
+                    pass = ble_scan_u16_find(f->uuids, f->uuid_count, uuids[i]);
+                }
+            }
+        }
+    }
+    if (pass) f->passed++; else f->rejected++;
+    taskEXIT_CRITICAL(&ble_scan_filter_lock);
+    return pass;
+}
+
+static int ble_scan_cmp_u16(const void *a, const void *b) {
+    return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+static int ble_scan_cmp_mac(const void *a, const void *b) {
+    return memcmp(a, b, 6);
+}
+
+/* An int, or a hex string like the "services" entries of a device dict */
+static uint16_t ble_scan_get_id(mp_obj_t obj) {
+    if (mp_obj_is_str(obj)) {
+        size_t len;
+        const char *str = mp_obj_str_get_data(obj, &len);
+        char *end;
+        char buf[8];
+        if (len == 0 || len >= sizeof(buf)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("bad 16-bit ID"));
+        }
+        memcpy(buf, str, len);
+        buf[len] = 0;
+        unsigned long v = strtoul(buf, &end, 16);
+        if (*end != 0 || v > 0xFFFF) {
+            mp_raise_ValueError(MP_ERROR_TEXT("bad 16-bit ID"));
+        }
+        return v;
+    }
+    mp_int_t v = mp_obj_get_int(obj);
+    if (v < 0 || v > 0xFFFF) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bad 16-bit ID"));
+    }
+    return v;
+}
+
+static size_t ble_scan_get_ids(mp_obj_t list, uint16_t *out, size_t max) {
+    if (list == mp_const_none) return 0;
+    size_t n;
+    mp_obj_t *items;
+    mp_obj_get_array(list, &n, &items);
+    if (n > max) {
+        mp_raise_ValueError(MP_ERROR_TEXT("too many filter IDs"));
+    }
+    for (size_t i = 0; i < n; i++) {
+        out[i] = ble_scan_get_id(items[i]);
+    }
+    qsort(out, n, sizeof(uint16_t), ble_scan_cmp_u16);
+    return n;
+}
+
+/*
+ * filter(macs=None, services=None, manufacturers=None, discover_every_ms=0,
+ * discover_window_ms=0) — replace the scan filter; no lists disables it.
+ */
+static mp_obj_t ble_scan_set_filter(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_macs, ARG_services, ARG_manufacturers, ARG_discover_every_ms, ARG_discover_window_ms };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_macs,               MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_services,           MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_manufacturers,      MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_discover_every_ms,  MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_discover_window_ms, MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    /* Build the new filter off to the side, then swap it in under the lock */
+    ble_scan_filter_t f;
+    memset(&f, 0, sizeof(f));
+    if (args[ARG_macs].u_obj != mp_const_none) {
+        size_t n;
+        mp_obj_t *items;
+        mp_obj_get_array(args[ARG_macs].u_obj, &n, &items);
+        if (n > BLE_SCAN_FILTER_MACS) {
+            mp_raise_ValueError(MP_ERROR_TEXT("too many filter MACs"));
+        }
+        for (size_t i = 0; i < n; i++) {
+            ble_scan_get_mac(items[i], f.macs[i]);
+        }
+        qsort(f.macs, n, 6, ble_scan_cmp_mac);
+        f.mac_count = n;
+    }
+    f.uuid_count = ble_scan_get_ids(args[ARG_services].u_obj, f.uuids, BLE_SCAN_FILTER_IDS);
+    f.mfr_count = ble_scan_get_ids(args[ARG_manufacturers].u_obj, f.mfrs, BLE_SCAN_FILTER_IDS);
+    f.enabled = args[ARG_macs].u_obj != mp_const_none || args[ARG_services].u_obj != mp_const_none ||
+                args[ARG_manufacturers].u_obj != mp_const_none;
+    mp_int_t every = args[ARG_discover_every_ms].u_int;
+    mp_int_t window = args[ARG_discover_window_ms].u_int;
+    if (every < 0 || window < 0 || (every > 0 && window >= every)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("need 0 <= discover_window_ms < discover_every_ms"));
+    }
+    f.every_ms = every;
+    f.window_ms = window;
+
+    taskENTER_CRITICAL(&ble_scan_filter_lock);
+    f.passed = ble_scan_filter.passed;
+    f.rejected = ble_scan_filter.rejected;
+    ble_scan_filter = f;
+    taskEXIT_CRITICAL(&ble_scan_filter_lock);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(ble_scan_filter_obj, 0, ble_scan_set_filter);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Scan result ring buffer                                                  */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * Filled straight from our own NimBLE discovery callback, on the NimBLE host
+ * task, instead of bluetooth.BLE's IRQ path which allocates two bytes
+ * objects and a tuple per result.  Single producer (host task), single
+ * consumer (MicroPython): head is only written by the producer and tail
+ * by the consumer, so neither side takes a lock.
+ *
+ * Record layout, 40 bytes, also what readinto() hands out:
+ *   addr[6] (big-endian, as bluetooth.BLE reports it)  addr_type:u8
+ *   rssi:i8  adv_len:u8  adv[31]
+ */
+#define BLE_SCAN_ADV_MAX    31
+#define BLE_SCAN_RECORD_LEN 40
+
+typedef struct {
+    uint8_t addr[6];
+    uint8_t addr_type;
+    int8_t rssi;
+    uint8_t adv_len;
+    uint8_t adv[BLE_SCAN_ADV_MAX];
+} ble_scan_record_t;
+
+typedef struct {
+    ble_scan_record_t *records;     /* outside the GC heap, PSRAM if present */
+    uint32_t capacity;              /* power of two */
+    volatile uint32_t head;         /* next slot to write (producer) */
+    volatile uint32_t tail;         /* next slot to read (consumer) */
+    volatile uint32_t received;     /* results seen by the callback */
+    volatile uint32_t dropped;      /* results lost to a full ring */
+    volatile bool scanning;
+} ble_scan_ring_t;
+
+static ble_scan_ring_t ble_scan_ring;
+
+static int ble_scan_gap_cb(struct ble_gap_event *event, void *arg) {
+    ble_scan_ring_t *ring = &ble_scan_ring;
+    switch (event->type) {
+        case BLE_GAP_EVENT_DISC: {
+            const struct ble_gap_disc_desc *d = &event->disc;
+            ring->received++;
+            uint8_t addr[6];
+            for (int i = 0; i < 6; i++) {
+                addr[i] = d->addr.val[5 - i];
+            }
+            uint8_t adv_len = d->length_data < BLE_SCAN_ADV_MAX ? d->length_data : BLE_SCAN_ADV_MAX;
+            if (!ble_scan_filter_pass(addr, d->data, adv_len)) {
+                return 0;
+            }
+            uint32_t head = ring->head;
+            uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+            if (head - tail >= ring->capacity) {
+                ring->dropped++;
+                return 0;
+            }
+            ble_scan_record_t *r = &ring->records[head & (ring->capacity - 1)];
+            memcpy(r->addr, addr, 6);
+            r->addr_type = d->addr.type;
+            r->rssi = d->rssi;
+            r->adv_len = adv_len;
+            memcpy(r->adv, d->data, adv_len);
+            __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+            return 0;
+        }
+        case BLE_GAP_EVENT_DISC_COMPLETE:
+            ring->scanning = false;
+            return 0;
+    }
+    return 0;
+}
+
+/* Hand a consumed prefix of the ring back to the producer */
+static inline void ble_scan_ring_release(ble_scan_ring_t *ring, uint32_t tail) {
+    __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+}
+
+/*
+ * start(capacity, interval_us=100000, window_us=30000, active=True) — begin
+ * an indefinite scan into a ring of capacity records (rounded up to a power
+ * of two).  BLE must already be active.
+ */
+static mp_obj_t ble_scan_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_capacity, ARG_interval_us, ARG_window_us, ARG_active };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_capacity,    MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_interval_us, MP_ARG_INT,  {.u_int = 100000} },
+        { MP_QSTR_window_us,   MP_ARG_INT,  {.u_int = 30000} },
+        { MP_QSTR_active,      MP_ARG_BOOL, {.u_bool = true} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ble_scan_ring_t *ring = &ble_scan_ring;
+    if (ring->scanning && ble_gap_disc_active()) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("scan already running"));
+    }
+    mp_int_t want = args[ARG_capacity].u_int;
+    if (want < 1 || want > 65536) {
+        mp_raise_ValueError(MP_ERROR_TEXT("capacity must be 1..65536"));
+    }
+    uint32_t capacity = 1;
+    while (capacity < (uint32_t)want) capacity <<= 1;
+
+    if (ring->records == NULL || ring->capacity != capacity) {
+        heap_caps_free(ring->records);
+        size_t size = (size_t)capacity * sizeof(ble_scan_record_t);
+        ring->records = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+        if (ring->records == NULL) {
+            ring->records = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+        }
+        if (ring->records == NULL) {
+            ring->capacity = 0;
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no memory for scan ring"));
+        }
+        ring->capacity = capacity;
+    }
+    ring->head = ring->tail = 0;
+    ring->received = ring->dropped = 0;
+
+    /* NimBLE takes interval and window in 0.625 ms units */
+    struct ble_gap_disc_params params = {
+        .itvl = args[ARG_interval_us].u_int / 625,
+        .window = args[ARG_window_us].u_int / 625,
+        .filter_policy = 0,
+        .limited = 0,
+        .passive = !args[ARG_active].u_bool,
+        .filter_duplicates = 0,
+    };
+    uint8_t own_addr_type;
+    int rc = ble_hs_id_infer_auto(0, &own_addr_type);
+    if (rc == 0) {
+        rc = ble_gap_disc(own_addr_type, BLE_HS_FOREVER, &params, ble_scan_gap_cb, NULL);
+    }
+    if (rc != 0) {
+        mp_raise_OSError(rc);
+    }
+    ring->scanning = true;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(ble_scan_start_obj, 1, ble_scan_start);
+
+/* stop() — end the scan started by start(); pending records stay readable */
+static mp_obj_t ble_scan_stop(void) {
+    ble_scan_ring_t *ring = &ble_scan_ring;
+    if (ring->scanning) {
+        int rc = ble_gap_disc_cancel();
+        ring->scanning = false;
+        if (rc != 0 && rc != BLE_HS_EALREADY) {
+            mp_raise_OSError(rc);
+        }
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_scan_stop_obj, ble_scan_stop);
+
+/*
+ * drain([seen]) — move every pending record into the device table, or merge
+ * them into the seen dict if one is given.  Returns how many.
+ */
+static mp_obj_t ble_scan_drain(size_t n_args, const mp_obj_t *args) {
+    ble_scan_ring_t *ring = &ble_scan_ring;
+    ble_scan_table_t *t = &ble_scan_table;
+    mp_obj_t seen_in = n_args > 0 ? args[0] : MP_OBJ_NULL;
+    if (seen_in != MP_OBJ_NULL && !mp_obj_is_dict_or_ordereddict(seen_in)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("seen must be a dict"));
+    }
+    if (seen_in == MP_OBJ_NULL && t->slots == NULL) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("call table() first"));
+    }
+
+    uint32_t now = mp_hal_ticks_ms();
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t n = head - tail;
+    for (; tail != head; tail++) {
+        const ble_scan_record_t *r = &ring->records[tail & (ring->capacity - 1)];
+        if (seen_in == MP_OBJ_NULL) {
+            ble_scan_table_update(t, r->addr, r->addr_type, r->rssi, r->adv, r->adv_len, now);
+        } else {
+            ble_scan_merge_adv(seen_in, MP_OBJ_NULL, r->addr, r->addr_type, r->rssi, r->adv, r->adv_len);
+            ble_scan_ring_release(ring, tail + 1);  /* merging allocates: free slots as we go */
+        }
+    }
+    ble_scan_ring_release(ring, tail);
+    return mp_obj_new_int_from_uint(n);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ble_scan_drain_obj, 0, 1, ble_scan_drain);
+
+/* readinto(buf) — copy whole pending records into buf, return how many */
+static mp_obj_t ble_scan_readinto(mp_obj_t buf_in) {
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_WRITE);
+    ble_scan_ring_t *ring = &ble_scan_ring;
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t n = 0;
+    uint8_t *out = buf.buf;
+    while (tail != head && (n + 1) * BLE_SCAN_RECORD_LEN <= buf.len) {
+        memcpy(out + n * BLE_SCAN_RECORD_LEN, &ring->records[tail & (ring->capacity - 1)],
+               BLE_SCAN_RECORD_LEN);
+        tail++;
+        n++;
+    }
+    ble_scan_ring_release(ring, tail);
+    return mp_obj_new_int_from_uint(n);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ble_scan_readinto_obj, ble_scan_readinto);
+
+/* info() — ring fill level and counters, device table occupancy */
+static mp_obj_t ble_scan_info(void) {
+    ble_scan_ring_t *ring = &ble_scan_ring;
+    ble_scan_table_t *t = &ble_scan_table;
+    mp_obj_t dict = mp_obj_new_dict(12);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_capacity), mp_obj_new_int_from_uint(ring->capacity));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_pending), mp_obj_new_int_from_uint(ring->head - ring->tail));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_received), mp_obj_new_int_from_uint(ring->received));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_dropped), mp_obj_new_int_from_uint(ring->dropped));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_scanning), mp_obj_new_bool(ring->scanning));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_devices), mp_obj_new_int_from_uint(t->count));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_table_slots), mp_obj_new_int_from_uint(t->capacity));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_evicted), mp_obj_new_int_from_uint(t->evicted));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_refused), mp_obj_new_int_from_uint(t->refused));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_filter), mp_obj_new_bool(ble_scan_filter.enabled));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_passed), mp_obj_new_int_from_uint(ble_scan_filter.passed));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_rejected), mp_obj_new_int_from_uint(ble_scan_filter.rejected));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(ble_scan_info_obj, ble_scan_info);
+
+#endif /* MICROPY_PY_BLUETOOTH && MICROPY_BLUETOOTH_NIMBLE */
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Module functions                                                         */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/* parse(addr, addr_type, rssi, adv) — one advertisement as a device dict */
+static mp_obj_t ble_scan_parse(size_t n_args, const mp_obj_t *args) {
+    const uint8_t *addr = ble_scan_get_addr(args[0]);
+    mp_buffer_info_t raw;
+    mp_get_buffer_raise(args[3], &raw, MP_BUFFER_READ);
+
+    ble_scan_adv_t adv;
+    ble_scan_parse_adv(raw.buf, raw.len, &adv);
+    return ble_scan_new_entry(addr, mp_obj_get_int(args[1]), mp_obj_get_int(args[2]), &adv);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ble_scan_parse_obj, 4, 4, ble_scan_parse);
+
+/*
+ * merge(seen, addr, addr_type, rssi, adv) — parse into the seen dict, keyed
+ * by the 6-byte address object.  Keeps the strongest RSSI and fills in a
+ * name or manufacturer data the entry was still missing.
+ */
+static mp_obj_t ble_scan_merge(size_t n_args, const mp_obj_t *args) {
+    if (!mp_obj_is_dict_or_ordereddict(args[0])) {
+        mp_raise_TypeError(MP_ERROR_TEXT("seen must be a dict"));
+    }
+    const uint8_t *addr = ble_scan_get_addr(args[1]);
+    mp_buffer_info_t raw;
+    mp_get_buffer_raise(args[4], &raw, MP_BUFFER_READ);
+    bool added = ble_scan_merge_adv(args[0], args[1], addr, mp_obj_get_int(args[2]),
+                                    mp_obj_get_int(args[3]), raw.buf, raw.len);
+    return mp_obj_new_bool(added);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ble_scan_merge_obj, 5, 5, ble_scan_merge);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Module registration                                                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+static const mp_rom_map_elem_t ble_scan_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ble_scan) },
+    { MP_ROM_QSTR(MP_QSTR_parse),    MP_ROM_PTR(&ble_scan_parse_obj) },
+    { MP_ROM_QSTR(MP_QSTR_merge),    MP_ROM_PTR(&ble_scan_merge_obj) },
+    #if MICROPY_PY_BLUETOOTH && MICROPY_BLUETOOTH_NIMBLE
+    { MP_ROM_QSTR(MP_QSTR_start),    MP_ROM_PTR(&ble_scan_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop),     MP_ROM_PTR(&ble_scan_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_drain),    MP_ROM_PTR(&ble_scan_drain_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&ble_scan_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_table),    MP_ROM_PTR(&ble_scan_table_obj) },
+    { MP_ROM_QSTR(MP_QSTR_results),  MP_ROM_PTR(&ble_scan_results_obj) },
+    { MP_ROM_QSTR(MP_QSTR_results_packed), MP_ROM_PTR(&ble_scan_results_packed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_seen),     MP_ROM_PTR(&ble_scan_seen_obj) },
+    { MP_ROM_QSTR(MP_QSTR_filter),   MP_ROM_PTR(&ble_scan_filter_obj) },
+    { MP_ROM_QSTR(MP_QSTR_info),     MP_ROM_PTR(&ble_scan_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_RECORD_LEN), MP_ROM_INT(BLE_SCAN_RECORD_LEN) },
+    #endif
+};
+static MP_DEFINE_CONST_DICT(ble_scan_module_globals, ble_scan_module_globals_table);
+
+const mp_obj_module_t ble_scan_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&ble_scan_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_ble_scan, ble_scan_module);
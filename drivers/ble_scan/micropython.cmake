@@ -0,0 +1,22 @@
+# Native BLE advertisement parsing for firmware/ble_bridge.py
+# Include this alongside rgb_panel_lvgl in USER_C_MODULES
+
+add_library(usermod_ble_scan INTERFACE)
+
+target_sources(usermod_ble_scan INTERFACE
+    ${CMAKE_CURRENT_LIST_DIR}/ble_scan.c
+)
+
+target_include_directories(usermod_ble_scan INTERFACE
+    ${CMAKE_CURRENT_LIST_DIR}
+)
+
+# NimBLE host headers for the native scan ring
+if(IDF_TARGET)
+    target_link_libraries(usermod_ble_scan INTERFACE
+        idf::bt
+        idf::heap
+    )
+endif()
+
+target_link_libraries(usermod INTERFACE usermod_ble_scan)
@@ -3,3 +3,8 @@ include("$(PORT_DIR)/boards/manifest.py")
 # Freeze panel init sequence into firmware (no filesystem dependency at boot)
 # BOARD_DIR is drivers/boards/GUITION_4848, so ../../.. is the repo root
 module("panel_init_guition_4848.py", base_path="$(BOARD_DIR)/../../../firmware")
+# Packed copy of the same sequence (firmware/tools/pack_init_cmds.py); the
+# bytes constant stays in flash and is what init_display() actually sends
+module("panel_init_guition_4848_blob.py", base_path="$(BOARD_DIR)/../../../firmware")
+# On-device display benchmark: import bench_display; bench_display.run()
+module("bench_display.py", base_path="$(BOARD_DIR)/../../../firmware")
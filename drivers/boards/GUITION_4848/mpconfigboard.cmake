@@ -10,6 +10,22 @@ set(SDKCONFIG_DEFAULTS
 # Partition table
 set(MICROPY_BOARD_PARTITION_TABLE ${MICROPY_BOARD_DIR}/partitions.csv)
 
+# LVGL software draw units.  The PARALLEL variant runs two, each in its own
+# FreeRTOS task, so rendering uses the second core:
+#   VARIANT=parallel ./build.sh guition_4848
+if(MICROPY_BOARD_VARIANT STREQUAL "PARALLEL")
+    set(RGB_PANEL_LVGL_DRAW_UNITS 2)
+else()
+    set(RGB_PANEL_LVGL_DRAW_UNITS 1)
+endif()
+
+# LVGL caches, taken from the PSRAM draw buffer pool (board_guition_4848.py):
+# decoded images in bytes, image headers and expanded glyphs in entries.
+# Size them against stats()["cache"] and pool_info().
+set(RGB_PANEL_LVGL_IMAGE_CACHE 131072)
+set(RGB_PANEL_LVGL_IMAGE_HEADER_CACHE 32)
+set(RGB_PANEL_LVGL_GLYPH_CACHE 256)
+
 # C display driver
 get_filename_component(_DRIVERS_DIR "${MICROPY_BOARD_DIR}/../.." ABSOLUTE)
 set(USER_C_MODULES ${_DRIVERS_DIR}/rgb_panel_lvgl/user_modules.cmake)
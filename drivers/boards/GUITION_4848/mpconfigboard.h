@@ -4,3 +4,9 @@
 // Enable UART REPL — this board has an external CH340 USB-UART on UART0,
 // not native USB. Same approach as ESP32_GENERIC_S3.
 #define MICROPY_HW_ENABLE_UART_REPL (1)
+
+// rgb_panel_lvgl: build the driver for this panel only (480x480, DIRECT
+// render mode), which drops PARTIAL mode.  RGBPanel() arguments must match.
+#define MICROPY_HW_RGB_PANEL_WIDTH       (480)
+#define MICROPY_HW_RGB_PANEL_HEIGHT      (480)
+#define MICROPY_HW_RGB_PANEL_RENDER_MODE (0)   // RENDER_DIRECT
@@ -3,7 +3,8 @@
 # Build MicroPython firmware with LVGL + RGB panel driver for a display board.
 #
 # Prerequisites:
-#   - ESP-IDF v5.2+ installed and sourced (. $IDF_PATH/export.sh)
+#   - ESP-IDF v5.2+ installed and sourced (. $IDF_PATH/export.sh), except
+#     for the unix build
 #   - Python 3.8+
 #
 # Usage:
@@ -11,6 +12,12 @@
 #   ./build.sh guition_4848 --compile  # Recompile only (deps already cloned)
 #   ./build.sh guition_4848 --clean    # Clean build directory
 #
+#   VARIANT=parallel ./build.sh guition_4848   # Board variant (see the
+#                                              # board's mpconfigboard.cmake)
+#
+#   ./build.sh unix                    # Host MicroPython (unix port) with the
+#                                      # simulated panel; no ESP-IDF needed
+#
 set -euo pipefail
 
 SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
@@ -21,10 +28,14 @@ FIRMWARE_DIR="${SCRIPT_DIR}/../firmware"
 MICROPYTHON_VERSION="v1.24.1"
 LV_BINDING_BRANCH="master"
 
+# Optional board variant, e.g. VARIANT=parallel
+BOARD_VARIANT="$(echo "${VARIANT:-}" | tr '[:lower:]' '[:upper:]')"
+
 # Build paths
 MPY_DIR="${BUILD_ROOT}/micropython"
 LV_BINDING_DIR="${BUILD_ROOT}/lv_binding_micropython"
 PORT_DIR="${MPY_DIR}/ports/esp32"
+UNIX_PORT_DIR="${MPY_DIR}/ports/unix"
 
 # ─── Helpers ──────────────────────────────────────────────────────────────────
 
@@ -43,6 +54,7 @@ check_idf() {
 # ─── Clone dependencies ──────────────────────────────────────────────────────
 
 clone_deps() {
+    local port_dir="${1:-${PORT_DIR}}"
     mkdir -p "${BUILD_ROOT}"
 
     # MicroPython
@@ -53,12 +65,11 @@ clone_deps() {
 
         blue "Building MicroPython cross-compiler..."
         make -C "${MPY_DIR}/mpy-cross" -j"$(nproc)"
-
-        blue "Initializing ESP32 port submodules..."
-        make -C "${PORT_DIR}" submodules
     else
         green "MicroPython already cloned at ${MPY_DIR}"
     fi
+    blue "Initializing $(basename "${port_dir}") port submodules..."
+    make -C "${port_dir}" submodules
 
     # lv_binding_micropython
     if [[ ! -d "${LV_BINDING_DIR}" ]]; then
@@ -93,6 +104,7 @@ compile() {
     blue "Building firmware..."
     blue "  Board: ${board_name}"
     blue "  BOARD_DIR: ${board_dir}"
+    blue "  Variant: ${BOARD_VARIANT:-default}"
     blue "  lv_conf.h: ${SCRIPT_DIR}/lv_conf.h"
 
     # Tell the build where to find lv_binding_micropython
@@ -103,10 +115,11 @@ compile() {
 
     make -C "${PORT_DIR}" \
         BOARD_DIR="${board_dir}" \
+        ${BOARD_VARIANT:+BOARD_VARIANT="${BOARD_VARIANT}"} \
         -j"$(nproc)"
 
     # Find the output binary
-    local build_dir="${PORT_DIR}/build-${board_upper}"
+    local build_dir="${PORT_DIR}/build-${board_upper}${BOARD_VARIANT:+-${BOARD_VARIANT}}"
     local bin_file="${build_dir}/firmware.bin"
 
     if [[ -f "${bin_file}" ]]; then
@@ -118,6 +131,24 @@ compile() {
     fi
 }
 
+# Host build: the unix port picks up drivers/rgb_panel_lvgl/micropython.mk
+compile_unix() {
+    blue "Building host MicroPython (unix port, simulated panel)..."
+    export LV_BINDINGS_DIR="${LV_BINDING_DIR}"
+    make -C "${UNIX_PORT_DIR}" \
+        USER_C_MODULES="${SCRIPT_DIR}" \
+        -j"$(nproc)"
+
+    local bin_file="${UNIX_PORT_DIR}/build-standard/micropython"
+    if [[ -x "${bin_file}" ]]; then
+        cp "${bin_file}" "${BUILD_ROOT}/micropython-host"
+        green "Host build: ${BUILD_ROOT}/micropython-host"
+        green "  Replay the UI: ${BUILD_ROOT}/micropython-host ${FIRMWARE_DIR}/tools/replay_ui.py"
+    else
+        die "Build succeeded but ${bin_file} not found"
+    fi
+}
+
 clean() {
     local board_name="$1"
     local board_upper
@@ -128,6 +159,7 @@ clean() {
     if [[ -d "${PORT_DIR}" ]]; then
         make -C "${PORT_DIR}" \
             BOARD_DIR="${board_dir}" \
+            ${BOARD_VARIANT:+BOARD_VARIANT="${BOARD_VARIANT}"} \
             clean 2>/dev/null || true
     fi
     green "Clean complete"
@@ -139,6 +171,22 @@ main() {
     local board_name="${1:?Usage: ./build.sh <board_name> [--compile|--clean]}"
     local mode="${2:-full}"
 
+    if [[ "${board_name}" == "unix" ]]; then
+        case "${mode}" in
+            --clean)
+                make -C "${UNIX_PORT_DIR}" clean 2>/dev/null || true
+                ;;
+            --compile)
+                compile_unix
+                ;;
+            full|*)
+                clone_deps "${UNIX_PORT_DIR}"
+                compile_unix
+                ;;
+        esac
+        return
+    fi
+
     check_idf
 
     case "${mode}" in
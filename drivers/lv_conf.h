@@ -23,6 +23,26 @@
 #ifndef LV_CONF_H
 #define LV_CONF_H
 
+/*====================
+   BOARD VARIANT
+ *====================*/
+
+/** Number of software draw units, passed as a compile definition by the
+ *  board's mpconfigboard.cmake (see drivers/rgb_panel_lvgl/user_modules.cmake).
+ *  1 keeps LVGL single-threaded. More runs every unit in its own FreeRTOS
+ *  task so rendering is spread over both ESP32-S3 cores; that needs an
+ *  OS layer and an allocator that is safe outside the MicroPython GIL. */
+#ifndef RGB_PANEL_LVGL_DRAW_UNITS
+    #define RGB_PANEL_LVGL_DRAW_UNITS 1
+#endif
+
+/** 1: route RGB565 fill, blend and blit through the kernels in
+ *  drivers/rgb_panel_lvgl/lv_draw_sw_pie.c (PIE SIMD on ESP32-S3).
+ *  Set by user_modules.cmake; 0 keeps LVGL's generic C loops. */
+#ifndef RGB_PANEL_LVGL_PIE
+    #define RGB_PANEL_LVGL_PIE 0
+#endif
+
 /* If you need to include anything here, do it inside the `__ASSEMBLY__` guard */
 #if  0 && defined(__ASSEMBLY__)
 #include "my_include.h"
@@ -47,7 +67,12 @@
  * - LV_STDLIB_CUSTOM:      Implement the functions externally
  */
 
-#define LV_USE_STDLIB_MALLOC    LV_STDLIB_MICROPYTHON
+#if RGB_PANEL_LVGL_DRAW_UNITS > 1
+    /* rgb_panel_lvgl.c: GC heap for MicroPython threads, heap_caps for draw threads */
+    #define LV_USE_STDLIB_MALLOC    LV_STDLIB_CUSTOM
+#else
+    #define LV_USE_STDLIB_MALLOC    LV_STDLIB_MICROPYTHON
+#endif
 #define LV_USE_STDLIB_STRING    LV_STDLIB_BUILTIN
 #define LV_USE_STDLIB_SPRINTF   LV_STDLIB_BUILTIN
 
@@ -98,7 +123,11 @@
  * - LV_OS_MQX
  * - LV_OS_SDL2
  * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+#if RGB_PANEL_LVGL_DRAW_UNITS > 1
+    #define LV_USE_OS   LV_OS_FREERTOS
+#else
+    #define LV_USE_OS   LV_OS_NONE
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
@@ -175,7 +204,7 @@
     /** Set number of draw units.
      *  - > 1 requires operating system to be enabled in `LV_USE_OS`.
      *  - > 1 means multiple threads will render the screen in parallel. */
-    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #define LV_DRAW_SW_DRAW_UNIT_CNT    RGB_PANEL_LVGL_DRAW_UNITS
 
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
@@ -201,10 +230,14 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
-    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    #if RGB_PANEL_LVGL_PIE
+        #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_CUSTOM
+    #else
+        #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    #endif
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
-        #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
+        #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE "lv_draw_sw_pie.h"
     #endif
 
     /** Enable drawing complex gradients in software: linear at an angle, radial or conical */
@@ -451,6 +484,7 @@ extern void mp_lv_deinit_gc();
  *  If size is not set to 0, the decoder will fail to decode when the cache is full.
  *  If size is 0, the cache function is not enabled and the decoded memory will be
  *  released immediately after use. */
+/* Boards set both through drivers/rgb_panel_lvgl/user_modules.cmake */
 #ifdef MICROPY_CACHE_SIZE
     #define LV_CACHE_DEF_SIZE   MICROPY_CACHE_SIZE
 #else
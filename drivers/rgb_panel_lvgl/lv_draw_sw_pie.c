@@ -0,0 +1,170 @@
+/*
+ * RGB565 fill, blend and blit kernels behind the LV_DRAW_SW_ASM_CUSTOM hooks
+ * in lv_draw_sw_pie.h.
+ *
+ * Solid fills and RGB565 copies move 8 pixels per instruction through the
+ * ESP32-S3 PIE vector unit (lv_draw_sw_pie.S) once the destination is 16-byte
+ * aligned.  The opacity and mask blends produce exactly what LVGL's
+ * lv_color_16_16_mix() does, but unpack the fill colour once per call instead
+ * of once per pixel; PIE has no 32-bit lane multiply, which that mix needs.
+ * Other targets (host builds) use the same C wrappers with scalar loops.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include "lv_draw_sw_pie.h"
+
+#if defined(ESP_PLATFORM)
+#include "esp_attr.h"
+#include "sdkconfig.h"
+#endif
+
+#if CONFIG_IDF_TARGET_ESP32S3
+#define RGB565_PIE 1
+#else
+#define RGB565_PIE 0
+#endif
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+/* Below this many pixels a row is not worth the alignment prologue */
+#define RGB565_PIE_MIN_PX 16
+
+rgb565_pie_counts_t rgb565_pie_counts;
+
+#if RGB565_PIE
+void rgb565_pie_fill_blocks(uint16_t *dst, uint32_t blocks, const uint16_t *color);
+void rgb565_pie_copy_blocks(uint16_t *dst, const uint16_t *src, uint32_t blocks);
+#endif
+
+#define ROW(p, stride) ((void *)((uint8_t *)(p) + (stride)))
+
+/* 0x07E0F81F spreads R, G and B with room for a 5-bit multiply */
+static inline uint32_t rgb565_spread(uint16_t c) {
+    return ((uint32_t)c | ((uint32_t)c << 16)) & 0x07E0F81FU;
+}
+
+static inline uint16_t rgb565_pack(uint32_t v) {
+    v &= 0x07E0F81FU;
+    return (uint16_t)((v >> 16) | v);
+}
+
+/* lv_color_16_16_mix(fg, bg, mix) with fg already spread */
+static inline uint16_t rgb565_mix(uint32_t fg, uint16_t fg16, uint16_t bg16, uint8_t mix) {
+    if (mix == 255 || bg16 == fg16) {
+        return fg16;
+    }
+    if (mix == 0) {
+        return bg16;
+    }
+    uint32_t bg = rgb565_spread(bg16);
+    return rgb565_pack((((fg - bg) * (((uint32_t)mix + 4) >> 3)) >> 5) + bg);
+}
+
+/* ── Solid fill ─────────────────────────────────────────────────────────── */
+
+static inline void IRAM_ATTR rgb565_fill_row(uint16_t *d, int32_t w, const uint16_t *color) {
+    #if RGB565_PIE
+    if (w >= RGB565_PIE_MIN_PX) {
+        while ((uintptr_t)d & 15) {
+            *d++ = *color;
+            w--;
+        }
+        uint32_t blocks = (uint32_t)w >> 3;
+        rgb565_pie_fill_blocks(d, blocks, color);
+        d += blocks * 8;
+        w -= (int32_t)blocks * 8;
+    }
+    #endif
+    while (w-- > 0) {
+        *d++ = *color;
+    }
+}
+
+void IRAM_ATTR rgb565_pie_fill(uint16_t *dst, int32_t w, int32_t h, int32_t stride,
+                               uint16_t color) {
+    for (int32_t y = 0; y < h; y++) {
+        rgb565_fill_row(dst, w, &color);
+        dst = ROW(dst, stride);
+    }
+}
+
+/* ── Blends ─────────────────────────────────────────────────────────────── */
+
+void IRAM_ATTR rgb565_pie_fill_opa(uint16_t *dst, int32_t w, int32_t h, int32_t stride,
+                                   uint16_t color, uint8_t opa) {
+    uint32_t fg = rgb565_spread(color);
+    uint16_t last_bg = color;
+    uint16_t last_res = color;
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            if (dst[x] != last_bg) {
+                last_bg = dst[x];
+                last_res = rgb565_mix(fg, color, last_bg, opa);
+            }
+            dst[x] = last_res;
+        }
+        dst = ROW(dst, stride);
+    }
+}
+
+void IRAM_ATTR rgb565_pie_fill_mask(uint16_t *dst, int32_t w, int32_t h, int32_t stride,
+                                    uint16_t color, const uint8_t *mask, int32_t mask_stride) {
+    uint32_t fg = rgb565_spread(color);
+    for (int32_t y = 0; y < h; y++) {
+        int32_t x = 0;
+        while (x < w) {
+            /* Glyph masks are mostly empty or solid: skip/fill runs of 4 */
+            if (x + 4 <= w && ((uintptr_t)(mask + x) & 3) == 0) {
+                uint32_t m4 = *(const uint32_t *)(mask + x);
+                if (m4 == 0) {
+                    x += 4;
+                    continue;
+                }
+                if (m4 == 0xFFFFFFFFU) {
+                    dst[x] = dst[x + 1] = dst[x + 2] = dst[x + 3] = color;
+                    x += 4;
+                    continue;
+                }
+            }
+            dst[x] = rgb565_mix(fg, color, dst[x], mask[x]);
+            x++;
+        }
+        dst = ROW(dst, stride);
+        mask += mask_stride;
+    }
+}
+
+/* ── RGB565 blit ────────────────────────────────────────────────────────── */
+
+static inline void IRAM_ATTR rgb565_copy_row(uint16_t *d, const uint16_t *s, int32_t w) {
+    #if RGB565_PIE
+    if (w >= RGB565_PIE_MIN_PX) {
+        while ((uintptr_t)d & 15) {
+            *d++ = *s++;
+            w--;
+        }
+        uint32_t blocks = (uint32_t)w >> 3;
+        rgb565_pie_copy_blocks(d, s, blocks);
+        d += blocks * 8;
+        s += blocks * 8;
+        w -= (int32_t)blocks * 8;
+    }
+    #endif
+    if (w > 0) {
+        memcpy(d, s, (size_t)w * sizeof(uint16_t));
+    }
+}
+
+void IRAM_ATTR rgb565_pie_copy(uint16_t *dst, int32_t dst_stride, const uint16_t *src,
+                               int32_t src_stride, int32_t w, int32_t h) {
+    for (int32_t y = 0; y < h; y++) {
+        rgb565_copy_row(dst, src, w);
+        dst = ROW(dst, dst_stride);
+        src = ROW(src, src_stride);
+    }
+}
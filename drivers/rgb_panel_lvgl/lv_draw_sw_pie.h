@@ -0,0 +1,75 @@
+/*
+ * LV_DRAW_SW_ASM_CUSTOM hooks for RGB565 targets (see lv_conf.h)
+ *
+ * LVGL's SW blender includes this from lv_draw_sw_blend_to_rgb565.c and
+ * tries each hook before its generic loop; LV_RESULT_INVALID falls back to
+ * the generic code.  The kernels live in lv_draw_sw_pie.c: solid fill and
+ * the RGB565 image blit use the ESP32-S3 PIE vector unit, the opacity and
+ * mask blends hoist the colour unpacking out of LVGL's per-pixel mix.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LV_DRAW_SW_PIE_H
+#define LV_DRAW_SW_PIE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Kernels: strides in bytes, as in LVGL's blend descriptors */
+void rgb565_pie_fill(uint16_t *dst, int32_t w, int32_t h, int32_t stride, uint16_t color);
+void rgb565_pie_fill_opa(uint16_t *dst, int32_t w, int32_t h, int32_t stride,
+                         uint16_t color, uint8_t opa);
+void rgb565_pie_fill_mask(uint16_t *dst, int32_t w, int32_t h, int32_t stride, uint16_t color,
+                          const uint8_t *mask, int32_t mask_stride);
+void rgb565_pie_copy(uint16_t *dst, int32_t dst_stride, const uint16_t *src, int32_t src_stride,
+                     int32_t w, int32_t h);
+
+/* Hook call counters, read by rgb_panel_lvgl.blend_info().  Plain
+ * increments: with parallel draw units a count may occasionally be lost. */
+typedef struct {
+    uint32_t fill;
+    uint32_t fill_opa;
+    uint32_t fill_mask;
+    uint32_t copy;
+} rgb565_pie_counts_t;
+extern rgb565_pie_counts_t rgb565_pie_counts;
+
+#ifdef LV_DRAW_SW_BLEND_PRIVATE_H
+
+static inline lv_result_t lv_draw_sw_pie_color_fill(lv_draw_sw_blend_fill_dsc_t *dsc) {
+    rgb565_pie_counts.fill++;
+    rgb565_pie_fill(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride,
+                    lv_color_to_u16(dsc->color));
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t lv_draw_sw_pie_color_opa(lv_draw_sw_blend_fill_dsc_t *dsc) {
+    rgb565_pie_counts.fill_opa++;
+    rgb565_pie_fill_opa(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride,
+                        lv_color_to_u16(dsc->color), dsc->opa);
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t lv_draw_sw_pie_color_mask(lv_draw_sw_blend_fill_dsc_t *dsc) {
+    rgb565_pie_counts.fill_mask++;
+    rgb565_pie_fill_mask(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride,
+                         lv_color_to_u16(dsc->color), dsc->mask_buf, dsc->mask_stride);
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t lv_draw_sw_pie_rgb565_copy(lv_draw_sw_blend_image_dsc_t *dsc) {
+    rgb565_pie_counts.copy++;
+    rgb565_pie_copy(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                    dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc)            lv_draw_sw_pie_color_fill(dsc)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc)   lv_draw_sw_pie_color_opa(dsc)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc)  lv_draw_sw_pie_color_mask(dsc)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc)    lv_draw_sw_pie_rgb565_copy(dsc)
+
+#endif /* LV_DRAW_SW_BLEND_PRIVATE_H */
+
+#endif /* LV_DRAW_SW_PIE_H */
@@ -5,8 +5,17 @@ add_library(usermod_rgb_panel_lvgl INTERFACE)
 
 target_sources(usermod_rgb_panel_lvgl INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/rgb_panel_lvgl.c
+    ${CMAKE_CURRENT_LIST_DIR}/lv_draw_sw_pie.c
 )
 
+# PIE inner loops for the blend kernels (the C wrappers fall back to scalar
+# loops elsewhere)
+if(IDF_TARGET STREQUAL "esp32s3")
+    target_sources(usermod_rgb_panel_lvgl INTERFACE
+        ${CMAKE_CURRENT_LIST_DIR}/lv_draw_sw_pie.S
+    )
+endif()
+
 target_include_directories(usermod_rgb_panel_lvgl INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
 )
@@ -0,0 +1,27 @@
+# Host build of the RGB panel driver for the MicroPython unix port, against
+# the simulated panel in rgb_panel_sim.c (the ESP32 firmware uses
+# micropython.cmake instead).  Point USER_C_MODULES at drivers/:
+#
+#   make -C ports/unix USER_C_MODULES=/path/to/ble-scale-sync/drivers
+#
+# drivers/build.sh unix does this.  Like user_modules.cmake, this pulls in
+# lv_binding_micropython from LV_BINDINGS_DIR.
+
+RGB_PANEL_DIR := $(USERMOD_DIR)
+
+LV_BINDINGS_DIR ?= $(abspath $(RGB_PANEL_DIR)/../../lv_binding_micropython)
+ifeq ($(wildcard $(LV_BINDINGS_DIR)/micropython.mk),)
+$(error lv_binding_micropython not found at $(LV_BINDINGS_DIR))
+endif
+
+# The bindings' makefile expects USERMOD_DIR to be its own directory
+USERMOD_DIR := $(LV_BINDINGS_DIR)
+include $(LV_BINDINGS_DIR)/micropython.mk
+USERMOD_DIR := $(RGB_PANEL_DIR)
+
+SRC_USERMOD_C += \
+	$(RGB_PANEL_DIR)/rgb_panel_lvgl.c \
+	$(RGB_PANEL_DIR)/lv_draw_sw_pie.c \
+	$(RGB_PANEL_DIR)/rgb_panel_sim.c
+
+CFLAGS_USERMOD += -I$(RGB_PANEL_DIR)
@@ -5,37 +5,218 @@
  * Extended with LVGL display driver registration and data-driven init.
  *
  * Targets ESP32-S3 with 16-bit RGB565 parallel bus.
- * SPI 3-wire bit-banged init (9-bit mode) for panel register programming.
- * Panel init sequence is passed from Python as a list of (cmd, data, delay) tuples.
- * LVGL tick is driven by an esp_timer (no Python tick_inc needed).
+ * SPI 3-wire init (9-bit mode) for panel register programming, on the SPI2
+ * peripheral or bit-banged.
+ * Panel init sequence is passed from Python as a list of (cmd, data, delay) tuples
+ * or as a pre-packed bytes blob.
+ * LVGL reads its tick from esp_timer (no Python tick_inc and no periodic
+ * interrupt); the refresh period can be changed per UI state.
+ * Optional bounce-buffer scan-out keeps PSRAM framebuffers stable under
+ * WiFi/BLE load, and the double-buffer sync copy can run on the async
+ * memcpy (GDMA) engine instead of the CPU.  PARTIAL render mode trades the
+ * second PSRAM framebuffer for small internal-SRAM draw buffers.  LVGL can
+ * be driven from a native refresh task instead of lv.task_handler(); it
+ * renders with the GIL held.
+ * After a soft reset the panel keeps running and attach() takes it over.
+ * Also builds on the unix port against a simulated panel (rgb_panel_sim.h).
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <string.h>
 
+#include "py/gc.h"
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "py/mphal.h"
+#include "py/mpthread.h"
 
+#if defined(ESP_PLATFORM)
 #include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "driver/spi_master.h"
+#include "esp_async_memcpy.h"
+#include "esp_attr.h"
+#include "esp_cache.h"
+#include "esp_heap_caps.h"
 #include "esp_lcd_panel_rgb.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_log.h"
+#include "esp_memory_utils.h"
 #include "esp_rom_sys.h"
+#include "esp_task.h"
 #include "esp_timer.h"
+#include "multi_heap.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
+#else
+/* Host build (unix port): ESP-IDF stand-ins and a memory-backed panel */
+#include "rgb_panel_sim.h"
+#endif
 
 /* LVGL is provided by lv_binding_micropython */
 #include "lvgl/lvgl.h"
 
+#include "lv_draw_sw_pie.h"
+
+#ifndef RGB_PANEL_SIM
+#define RGB_PANEL_SIM 0
+#endif
+
 static const char *TAG = "rgb_panel_lvgl";
 
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Object type                                                              */
 /* ────────────────────────────────────────────────────────────────────────── */
 
+/*
+ * State shared with the RGB panel ISR.  The MicroPython heap lives in PSRAM,
+ * so this is allocated separately from internal RAM: with
+ * CONFIG_LCD_RGB_ISR_IRAM_SAFE the ISR keeps running while the flash cache is
+ * disabled and must not touch anything behind it.
+ */
+typedef struct {
+    /* Bounce-buffer refill accounting */
+    uint32_t frame_period_us;       /* nominal, derived from the timings */
+    uint32_t bb_deadline_us;        /* time to drain one bounce buffer */
+    int64_t bb_last_frame_us;
+    volatile uint32_t bb_frames;
+    volatile uint32_t bb_underruns;
+
+    /* Async sync-copy completion */
+    volatile uint32_t copies_pending;
+    SemaphoreHandle_t copy_done;
+
+    /* Scan-out frames and buffer swaps */
+    volatile uint32_t frames;       /* VSYNCs since init() */
+    int64_t last_vsync_us;
+    volatile uint32_t frame_avg_us; /* measured frame period, smoothed */
+    volatile uint32_t swap_pending; /* a new buffer was queued, not yet latched */
+    volatile uint32_t swaps;
+    SemaphoreHandle_t swap_done;
+    int64_t first_swap_us;          /* first buffer swap latched, 0 = none yet */
+    volatile int64_t swap_latched_us; /* when the last swap took effect */
+} rgb_panel_isr_ctx_t;
+
+/*
+ * Render statistics, kept twice: [0] since init()/reset_stats(), [1] since
+ * the last stats() call.  Only plain adds on the LVGL side, nothing in ISRs.
+ */
+typedef struct {
+    int64_t since_us;
+    uint32_t refreshes;             /* LVGL refresh timer runs */
+    uint32_t renders;               /* refreshes that flushed something */
+    uint32_t flushes;               /* areas handed to flush_cb */
+    uint64_t px_flushed;
+    uint64_t bytes_copied;          /* sync copies (DIRECT) / strip copies (PARTIAL) */
+    uint64_t flush_us;              /* time spent inside flush_cb */
+    uint64_t copy_us;               /* DIRECT sync copy, CPU and DMA, until landed */
+    uint64_t gap_us;                /* time between refresh timer runs */
+    uint32_t gap_max_us;
+    uint32_t swaps;                 /* swaps timed from queue to latch */
+    uint64_t swap_us;
+    uint32_t swap_max_us;
+} rgb_panel_stats_t;
+
+#define RGB_PANEL_STATS_TOTAL  0
+#define RGB_PANEL_STATS_WINDOW 1
+
+/* Max rectangles kept per frame for the deferred sync copy */
+#define RGB_PANEL_SYNC_RECTS 16
+
+/* render_mode values (exported as RENDER_DIRECT / RENDER_PARTIAL) */
+#define RGB_PANEL_RENDER_DIRECT  0  /* LVGL draws into two PSRAM framebuffers */
+#define RGB_PANEL_RENDER_PARTIAL 1  /* LVGL draws into SRAM strips, one PSRAM framebuffer */
+
+/* spi_backend values (exported as SPI_BITBANG / SPI_HW) */
+#define RGB_PANEL_SPI_BITBANG 0     /* GPIO toggling, ~30 us per 9-bit word */
+#define RGB_PANEL_SPI_HW      1     /* SPI2 peripheral, one transaction per command */
+#define RGB_PANEL_SPI_HOST    SPI2_HOST
+#define RGB_PANEL_SPI_MAX_TX  128   /* bytes per transaction: 9 * 113 bits */
+
+/*
+ * Board specialisation.  A board's mpconfigboard.h may fix the panel at
+ * compile time; the constructor then only accepts matching arguments, and
+ * the flush and copy paths see the geometry as constants:
+ *   MICROPY_HW_RGB_PANEL_WIDTH, MICROPY_HW_RGB_PANEL_HEIGHT
+ *   MICROPY_HW_RGB_PANEL_RENDER_MODE     RGB_PANEL_RENDER_DIRECT or _PARTIAL
+ * and leave out what it does not use (1 = built in, the default):
+ *   MICROPY_HW_RGB_PANEL_SPI_INIT        SPI 3-wire panel init, init_cmds
+ *   MICROPY_HW_RGB_PANEL_BOUNCE          bounce-buffer scan-out
+ * A fixed DIRECT render mode also drops PARTIAL mode.  Without any of these
+ * the driver stays fully runtime-configurable.
+ */
+#ifdef MICROPY_HW_RGB_PANEL_WIDTH
+#define RGB_PANEL_WIDTH(self)       ((int)MICROPY_HW_RGB_PANEL_WIDTH)
+#else
+#define RGB_PANEL_WIDTH(self)       ((int)(self)->width)
+#endif
+#ifdef MICROPY_HW_RGB_PANEL_HEIGHT
+#define RGB_PANEL_HEIGHT(self)      ((int)MICROPY_HW_RGB_PANEL_HEIGHT)
+#else
+#define RGB_PANEL_HEIGHT(self)      ((int)(self)->height)
+#endif
+#define RGB_PANEL_STRIDE(self)      ((size_t)RGB_PANEL_WIDTH(self) * sizeof(uint16_t))
+
+#ifdef MICROPY_HW_RGB_PANEL_RENDER_MODE
+#define RGB_PANEL_HAS_PARTIAL       (MICROPY_HW_RGB_PANEL_RENDER_MODE == RGB_PANEL_RENDER_PARTIAL)
+#define RGB_PANEL_IS_PARTIAL(self)  RGB_PANEL_HAS_PARTIAL
+#else
+#define RGB_PANEL_HAS_PARTIAL       1
+#define RGB_PANEL_IS_PARTIAL(self)  ((self)->render_mode == RGB_PANEL_RENDER_PARTIAL)
+#endif
+
+#ifndef MICROPY_HW_RGB_PANEL_SPI_INIT
+#define MICROPY_HW_RGB_PANEL_SPI_INIT 1
+#endif
+#ifndef MICROPY_HW_RGB_PANEL_BOUNCE
+#define MICROPY_HW_RGB_PANEL_BOUNCE 1
+#endif
+#if MICROPY_HW_RGB_PANEL_BOUNCE
+#define RGB_PANEL_BB_LINES(self)    ((self)->bb_lines)
+#else
+#define RGB_PANEL_BB_LINES(self)    0
+#endif
+
+/* init() stages timed for boot_times(); names in rgb_panel_boot_names[] */
+enum {
+    RGB_PANEL_BOOT_ALLOC,           /* ISR state, PARTIAL draw buffers */
+    RGB_PANEL_BOOT_SPI_SETUP,
+    RGB_PANEL_BOOT_INIT_CMDS,
+    RGB_PANEL_BOOT_PANEL_CREATE,    /* esp_lcd_new_rgb_panel: framebuffers, DMA */
+    RGB_PANEL_BOOT_PANEL_INIT,      /* reset + init, starts scan-out */
+    RGB_PANEL_BOOT_BACKLIGHT,
+    RGB_PANEL_BOOT_LVGL,            /* async copy, display registration */
+    RGB_PANEL_BOOT_LVGL_TASK,
+    RGB_PANEL_BOOT_STAGES,
+};
+
+/* snapshot_chunks() encodings */
+#define RGB_PANEL_SNAPSHOT_RAW   0  /* framebuffer bytes, zero-copy */
+#define RGB_PANEL_SNAPSHOT_RLE   1  /* RGB565 run-length packets */
+#define RGB_PANEL_SNAPSHOT_DELTA 2  /* RLE of each row XORed with the row above */
+
+/* Native LVGL refresh task (lvgl_task=True) */
+#define RGB_PANEL_LVGL_TASK_STACK (16 * 1024)
+#define RGB_PANEL_LVGL_TASK_PRIO  (ESP_TASK_PRIO_MIN + 2)   /* just above the MicroPython task */
+#define RGB_PANEL_LVGL_TASK_MAX_SLEEP_MS 1000   /* with no LVGL timer due */
+
+/* Backlight PWM (backlight_freq > 0): the last LEDC timer and channel, as
+ * machine.PWM hands them out from 0 up */
+#define RGB_PANEL_BL_LEDC_MODE    LEDC_LOW_SPEED_MODE
+#define RGB_PANEL_BL_LEDC_TIMER   LEDC_TIMER_3
+#define RGB_PANEL_BL_LEDC_CHANNEL LEDC_CHANNEL_7
+#define RGB_PANEL_BL_DUTY_BITS    10
+
+/* Auto-dim states (auto_dim()) */
+enum {
+    RGB_PANEL_DIM_AWAKE,            /* counting down the timeout */
+    RGB_PANEL_DIM_FADING,           /* fading to the dim level */
+    RGB_PANEL_DIM_DIMMED,           /* at a dim level above 0 */
+    RGB_PANEL_DIM_BLANK,            /* dark, scan-out and rendering stopped */
+};
+
 typedef struct _rgb_panel_obj_t {
     mp_obj_base_t base;
 
@@ -49,6 +230,9 @@ typedef struct _rgb_panel_obj_t {
     gpio_num_t spi_cs;
     gpio_num_t spi_clk;
     gpio_num_t spi_mosi;
+    uint8_t spi_backend;
+    uint32_t spi_freq;
+    spi_device_handle_t spi_dev;    /* SPI_HW while init_cmds run, else NULL */
 
     /* RGB signal pins */
     gpio_num_t pclk;
@@ -68,30 +252,702 @@ typedef struct _rgb_panel_obj_t {
     uint8_t vsync_back_porch;
     uint8_t vsync_front_porch;
 
+    /* Bounce buffers (0 lines = scan out straight from PSRAM) */
+    uint16_t bb_lines;
+    int8_t bb_core;                 /* core for the refill ISR, -1 = caller's */
+
+    /* Render mode; PARTIAL draw buffers live in internal DMA-capable RAM */
+    uint8_t render_mode;
+    uint8_t num_fbs;
+    uint8_t draw_buf_count;
+    uint16_t draw_buf_lines;
+    void *draw_buf[2];
+
+    /* Async memcpy for the double-buffer sync copy (NULL = CPU memcpy) */
+    bool async_copy;
+    async_memcpy_handle_t mcp;
+    int32_t copy_y1, copy_y2;       /* rows written by DMA since the last wait */
+
+    /* Deferred double-buffer sync: last frame's dirty areas, coalesced into
+     * non-overlapping rectangles, copied src -> dst once the swap latches */
+    lv_area_t sync_rects[RGB_PANEL_SYNC_RECTS];
+    uint8_t sync_count;
+    uint8_t *sync_src;
+    uint8_t *sync_dst;
+
+    /* Sync-copy counters (bytes) */
+    uint32_t sync_frames;
+    uint32_t sync_areas_last;       /* areas flushed in the last frame */
+    uint32_t sync_rects_last;       /* rectangles copied for it */
+    uint32_t sync_bytes_last;       /* bytes copied for it */
+    uint32_t sync_dirty_last;       /* bytes LVGL flushed in it */
+    uint64_t sync_bytes_total;
+    uint64_t sync_dirty_total;
+
+    /* Render statistics */
+    rgb_panel_stats_t stats[2];
+    int64_t refr_last_us;
+    int64_t swap_queued_us;         /* draw_bitmap() of the pending swap, 0 = none */
+
+    /* Newest complete frame: on screen, or latched at the next VSYNC */
+    uint8_t *front_fb;
+
+    /* Native LVGL refresh task: runs lv_timer_handler() under lvgl_lock */
+    bool lvgl_task;
+    volatile bool task_run;
+    SemaphoreHandle_t lvgl_lock;    /* recursive; always taken before the GIL */
+    SemaphoreHandle_t task_exit;
+    SemaphoreHandle_t task_wake;    /* given by unlock(): Python changed the UI */
+    mp_obj_dict_t *task_globals;
+
+    /* Pixel-buffer pools (bytes, 0 = off), created by the first init() */
+    uint32_t pool_size;
+    uint32_t sram_pool_size;
+
+    /* Boot profiling: per-stage init() durations */
+    bool boot_log;
+    int64_t boot_start_us;
+    int64_t boot_mark_us;
+    uint32_t boot_us[RGB_PANEL_BOOT_STAGES];
+
     /* Control pins */
     gpio_num_t backlight;
 
+    /* Backlight brightness (%), on LEDC PWM when bl_freq > 0, else on/off */
+    uint32_t bl_freq;
+    uint8_t bl_level;               /* last level set, or a fade's target */
+    uint8_t bl_on_level;            /* restored by wake() */
+
+    /* Auto-dim: an LVGL timer, so it runs in the rendering context */
+    lv_timer_t *dim_timer;
+    uint32_t dim_timeout_ms;
+    uint32_t dim_fade_ms;
+    uint8_t dim_level;
+    uint8_t dim_state;
+    uint32_t dim_blanks;            /* times scan-out was stopped */
+
     /* Panel init commands (Python list or None) */
     mp_obj_t init_cmds;
 
     /* LVGL display */
     lv_display_t *lv_disp;
+    uint32_t refr_ms;               /* refresh timer period, refresh_period() */
 
-    /* LVGL tick timer */
-    esp_timer_handle_t tick_timer;
+    /* ISR-side state (internal RAM) */
+    rgb_panel_isr_ctx_t *isr;
 } rgb_panel_obj_t;
 
 /* Forward declarations */
 static const mp_obj_type_t rgb_panel_type;
+static mp_obj_t rgb_panel_lock(mp_obj_t self_in);
+static mp_obj_t rgb_panel_unlock(mp_obj_t self_in);
+
+/*
+ * Warm-restart slot.  A soft reset wipes the GC heap, RGBPanel objects
+ * included, but not C statics or the heap_caps memory they point to: the
+ * esp_lcd panel keeps scanning out its framebuffers and its ISR only uses the
+ * internal-RAM context.  init() leaves the hardware state here so attach()
+ * on the next boot can adopt it without the init sequence and panel setup;
+ * key fingerprints the constructor arguments it was created with.
+ */
+typedef struct {
+    esp_lcd_panel_handle_t panel;   /* NULL = empty */
+    rgb_panel_isr_ctx_t *isr;
+    async_memcpy_handle_t mcp;
+    void *draw_buf[2];
+    uint8_t *front_fb;              /* DIRECT: last buffer queued for scan-out */
+    uint32_t bl_freq;               /* after setup_backlight(), 0 if PWM fell back */
+    uint32_t key;
+    bool blank;                     /* scan-out stopped by auto-dim */
+} rgb_panel_slot_t;
+
+static rgb_panel_slot_t rgb_panel_slot;
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Trace events                                                             */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * A wrapping ring of (id, timestamp, arg) events for following one reading
+ * from the BLE stack to the panel.  The driver emits the render-side events
+ * below, Python code emits its own through trace() (ids >= TRACE_USER), and
+ * firmware/trace.py turns a read-out into a Chrome trace.  Emitting is a
+ * single atomic increment plus a 12-byte store, safe from the RGB ISR: the
+ * ring is in internal RAM and nothing is recorded until trace_start().
+ * Readers may see a record that is being overwritten; it is a debug aid.
+ */
+#define RGB_PANEL_TRACE_REFR_START   1  /* LVGL refresh timer fired */
+#define RGB_PANEL_TRACE_FLUSH_BEGIN  2  /* flush_cb entered, arg = area px */
+#define RGB_PANEL_TRACE_FLUSH_END    3  /* flush_cb returned, arg = area px */
+#define RGB_PANEL_TRACE_SWAP_QUEUED  4  /* DIRECT: frame handed to esp_lcd */
+#define RGB_PANEL_TRACE_SWAP         5  /* ISR: new frame latched for scan-out, arg = swaps */
+#define RGB_PANEL_TRACE_TIMER_BEGIN  6  /* native task: lv_timer_handler() */
+#define RGB_PANEL_TRACE_TIMER_END    7  /*   ... returned, arg = next sleep ms */
+#define RGB_PANEL_TRACE_USER        64  /* first id for trace() callers */
+
+typedef struct {
+    uint32_t t_us;                  /* esp_timer, low 32 bits */
+    uint16_t id;
+    uint16_t reserved;
+    int32_t arg;
+} rgb_panel_trace_ev_t;
+
+typedef struct {
+    rgb_panel_trace_ev_t *events;
+    uint32_t capacity;              /* power of two */
+    volatile uint32_t head;         /* total events emitted */
+    volatile bool enabled;
+} rgb_panel_trace_t;
+
+static rgb_panel_trace_t rgb_panel_trace_ring;
+
+static IRAM_ATTR void rgb_panel_trace_at(uint16_t id, int32_t arg, uint32_t t_us) {
+    rgb_panel_trace_t *tr = &rgb_panel_trace_ring;
+    if (!tr->enabled) return;
+    uint32_t i = __atomic_fetch_add(&tr->head, 1, __ATOMIC_RELAXED);
+    rgb_panel_trace_ev_t *ev = &tr->events[i & (tr->capacity - 1)];
+    ev->t_us = t_us;
+    ev->id = id;
+    ev->arg = arg;
+}
+
+static inline IRAM_ATTR void rgb_panel_trace(uint16_t id, int32_t arg) {
+    if (rgb_panel_trace_ring.enabled) {
+        rgb_panel_trace_at(id, arg, (uint32_t)esp_timer_get_time());
+    }
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  LVGL tick                                                                */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * LVGL asks for the time instead of counting lv_tick_inc() calls, so there is
+ * no 5 ms timer interrupt running while the UI sits idle.  Stateless: it can
+ * stay installed after deinit().
+ */
+static uint32_t rgb_panel_tick_get_cb(void) {
+    #if RGB_PANEL_SIM
+    return rgb_panel_sim_tick_ms();
+    #else
+    return (uint32_t)(esp_timer_get_time() / 1000);
+    #endif
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  LVGL allocator for parallel draw units                                   */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+/*
+ * With RGB_PANEL_LVGL_DRAW_UNITS > 1 (lv_conf.h) the SW draw units render in
+ * their own FreeRTOS tasks, which allocate scratch memory (masks, temporary
+ * layers) while the refresh thread holds the GIL and waits for them.  They
+ * cannot touch the GC heap, so:
+ *   - MicroPython threads (which always hold the GIL inside LVGL) use the GC
+ *     heap, exactly as LV_STDLIB_MICROPYTHON does, so Python objects
+ *     referenced from LVGL memory stay reachable;
+ *   - any other task gets memory from heap_caps, internal SRAM first.
+ * Frees follow the block, not the caller.  A draw task releasing a GC block
+ * leaves it for the collector: nothing references it any more.
+ */
+#if !MICROPY_PY_THREAD
+#error "RGB_PANEL_LVGL_DRAW_UNITS > 1 needs MICROPY_PY_THREAD"
+#endif
+
+static inline bool lv_mem_caller_is_mp(void) {
+    return mp_thread_get_state() != NULL;
+}
+
+static bool lv_mem_in_gc_heap(const void *p) {
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL;) {
+        if ((const byte *)p >= area->gc_pool_start && (const byte *)p < area->gc_pool_end) {
+            return true;
+        }
+        #if MICROPY_GC_SPLIT_HEAP
+        area = area->next;
+        #else
+        area = NULL;
+        #endif
+    }
+    return false;
+}
+
+static void *lv_mem_caps_alloc(size_t size) {
+    return heap_caps_malloc_prefer(size, 2,
+                                   MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+                                   MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+void lv_mem_init(void) {
+}
+
+void lv_mem_deinit(void) {
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) {
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+    LV_UNUSED(pool);
+}
+
+void *lv_malloc_core(size_t size) {
+    if (!lv_mem_caller_is_mp()) {
+        return lv_mem_caps_alloc(size);
+    }
+    #if MICROPY_MALLOC_USES_ALLOCATED_SIZE
+    return gc_alloc(size, 0);
+    #else
+    return m_malloc(size);
+    #endif
+}
+
+void *lv_realloc_core(void *p, size_t new_size) {
+    if (p == NULL) {
+        return lv_malloc_core(new_size);
+    }
+    if (!lv_mem_in_gc_heap(p)) {
+        return heap_caps_realloc(p, new_size, MALLOC_CAP_8BIT);
+    }
+    if (lv_mem_caller_is_mp()) {
+        #if MICROPY_MALLOC_USES_ALLOCATED_SIZE
+        return gc_realloc(p, new_size, true);
+        #else
+        return m_realloc(p, new_size);
+        #endif
+    }
+    /* GC block grown from a draw task: move it out.  gc_nbytes() only reads
+     * the allocation table, and the block is live (the caller owns it). */
+    void *q = lv_mem_caps_alloc(new_size);
+    if (q != NULL) {
+        size_t old = gc_nbytes(p);
+        memcpy(q, p, old < new_size ? old : new_size);
+    }
+    return q;
+}
+
+void lv_free_core(void *p) {
+    if (p == NULL) {
+        return;
+    }
+    if (!lv_mem_in_gc_heap(p)) {
+        heap_caps_free(p);
+    } else if (lv_mem_caller_is_mp()) {
+        #if MICROPY_MALLOC_USES_ALLOCATED_SIZE
+        gc_free(p);
+        #else
+        m_free(p);
+        #endif
+    }
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) {
+    LV_UNUSED(mon_p);
+}
+
+lv_result_t lv_mem_test_core(void) {
+    return LV_RESULT_OK;
+}
+#endif
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Draw buffer pools                                                        */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * LVGL allocates pixel memory (layers, decoded images, glyph bitmaps) through
+ * its draw_buf handlers.  By default that is lv_malloc(), i.e. the GC heap,
+ * where every block is scanned word by word on each collection even though
+ * it holds no pointers.  With pool_size / sram_pool_size set, the handlers
+ * take it from TLSF heaps (ESP-IDF multi_heap) instead: layers of up to
+ * LV_DRAW_LAYER_SIMPLE_BUF_SIZE try internal SRAM first, everything else
+ * PSRAM, and lv_malloc() stays the fallback.
+ *
+ * Widgets, styles and anything else that may point at Python objects keep
+ * coming from LVGL's allocator: they are reachable from mp_lv_roots only
+ * because they live in the GC heap.
+ *
+ * The pools outlive deinit(): buffers from them may still be cached by LVGL.
+ * They also outlive a soft reset (C statics are not reset with the GC heap);
+ * when lv_init() has run again they are emptied and hooked into the new
+ * handlers.
+ */
+#define RGB_PANEL_POOL_HOT_MAX  LV_DRAW_LAYER_SIMPLE_BUF_SIZE
+
+typedef struct {
+    multi_heap_handle_t heap;
+    uint8_t *start;
+    uint8_t *end;
+    size_t size;
+} rgb_panel_pool_t;
+
+enum { RGB_PANEL_BUFS_LAYER, RGB_PANEL_BUFS_IMAGE, RGB_PANEL_BUFS_FONT, RGB_PANEL_BUFS_COUNT };
+
+typedef struct {
+    rgb_panel_pool_t psram;
+    rgb_panel_pool_t sram;
+    portMUX_TYPE lock;              /* shared by both heaps (draw units may run in parallel) */
+    lv_draw_buf_malloc_cb prev_malloc[RGB_PANEL_BUFS_COUNT];
+    lv_draw_buf_free_cb prev_free[RGB_PANEL_BUFS_COUNT];
+    uint32_t fallbacks;             /* allocations the pools could not take */
+    bool installed;
+} rgb_panel_pools_t;
+
+static rgb_panel_pools_t rgb_panel_pools = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static bool rgb_panel_pool_create(rgb_panel_pool_t *pool, size_t size, uint32_t caps) {
+    if (size == 0) {
+        return true;
+    }
+    uint8_t *mem = heap_caps_malloc(size, caps);
+    if (mem == NULL) {
+        return false;
+    }
+    pool->heap = multi_heap_register(mem, size);
+    if (pool->heap == NULL) {
+        heap_caps_free(mem);
+        return false;
+    }
+    multi_heap_set_lock(pool->heap, &rgb_panel_pools.lock);
+    pool->start = mem;
+    pool->end = mem + size;
+    pool->size = size;
+    return true;
+}
+
+/* Drop everything allocated from the pool: re-register the same memory */
+static void rgb_panel_pool_reset(rgb_panel_pool_t *pool) {
+    if (pool->heap == NULL) {
+        return;
+    }
+    pool->heap = multi_heap_register(pool->start, pool->size);
+    multi_heap_set_lock(pool->heap, &rgb_panel_pools.lock);
+}
+
+static inline bool rgb_panel_pool_owns(const rgb_panel_pool_t *pool, const void *p) {
+    return pool->heap != NULL && (const uint8_t *)p >= pool->start && (const uint8_t *)p < pool->end;
+}
+
+static inline void *rgb_panel_pool_alloc(rgb_panel_pool_t *pool, size_t size) {
+    /* 16-byte aligned so the PIE kernels run from the first pixel */
+    return pool->heap != NULL ? multi_heap_aligned_alloc(pool->heap, size, 16) : NULL;
+}
+
+static void *rgb_panel_bufs_malloc(int set, size_t size, lv_color_format_t cf) {
+    rgb_panel_pools_t *pools = &rgb_panel_pools;
+    void *buf = NULL;
+    if (set == RGB_PANEL_BUFS_LAYER && size <= RGB_PANEL_POOL_HOT_MAX) {
+        buf = rgb_panel_pool_alloc(&pools->sram, size);
+    }
+    if (buf == NULL) {
+        buf = rgb_panel_pool_alloc(&pools->psram, size);
+    }
+    if (buf == NULL) {
+        pools->fallbacks++;
+        buf = pools->prev_malloc[set](size, cf);
+    }
+    return buf;
+}
+
+static void rgb_panel_bufs_free(int set, void *buf) {
+    rgb_panel_pools_t *pools = &rgb_panel_pools;
+    if (rgb_panel_pool_owns(&pools->sram, buf)) {
+        multi_heap_free(pools->sram.heap, buf);
+    } else if (rgb_panel_pool_owns(&pools->psram, buf)) {
+        multi_heap_free(pools->psram.heap, buf);
+    } else {
+        /* Allocated before the pools were installed, or a fallback */
+        pools->prev_free[set](buf);
+    }
+}
+
+static void *rgb_panel_layer_malloc(size_t size, lv_color_format_t cf) {
+    return rgb_panel_bufs_malloc(RGB_PANEL_BUFS_LAYER, size, cf);
+}
+static void rgb_panel_layer_free(void *buf) {
+    rgb_panel_bufs_free(RGB_PANEL_BUFS_LAYER, buf);
+}
+static void *rgb_panel_image_malloc(size_t size, lv_color_format_t cf) {
+    return rgb_panel_bufs_malloc(RGB_PANEL_BUFS_IMAGE, size, cf);
+}
+static void rgb_panel_image_free(void *buf) {
+    rgb_panel_bufs_free(RGB_PANEL_BUFS_IMAGE, buf);
+}
+static void *rgb_panel_font_malloc(size_t size, lv_color_format_t cf) {
+    return rgb_panel_bufs_malloc(RGB_PANEL_BUFS_FONT, size, cf);
+}
+static void rgb_panel_font_free(void *buf) {
+    rgb_panel_bufs_free(RGB_PANEL_BUFS_FONT, buf);
+}
+
+static void rgb_panel_pools_hook(rgb_panel_pools_t *pools) {
+    lv_draw_buf_handlers_t *h[RGB_PANEL_BUFS_COUNT] = {
+        lv_draw_buf_get_handlers(), lv_draw_buf_get_image_handlers(), lv_draw_buf_get_font_handlers(),
+    };
+    static const lv_draw_buf_malloc_cb mallocs[RGB_PANEL_BUFS_COUNT] = {
+        rgb_panel_layer_malloc, rgb_panel_image_malloc, rgb_panel_font_malloc,
+    };
+    static const lv_draw_buf_free_cb frees[RGB_PANEL_BUFS_COUNT] = {
+        rgb_panel_layer_free, rgb_panel_image_free, rgb_panel_font_free,
+    };
+    for (int i = 0; i < RGB_PANEL_BUFS_COUNT; i++) {
+        pools->prev_malloc[i] = h[i]->buf_malloc_cb;
+        pools->prev_free[i] = h[i]->buf_free_cb;
+        h[i]->buf_malloc_cb = mallocs[i];
+        h[i]->buf_free_cb = frees[i];
+    }
+    pools->installed = true;
+}
+
+static void rgb_panel_glyphs_drop(void);
+
+/* Create the pools (first init() only) and hook LVGL's draw_buf handlers */
+static void rgb_panel_pools_install(rgb_panel_obj_t *self) {
+    rgb_panel_pools_t *pools = &rgb_panel_pools;
+    if (self->pool_size == 0 && self->sram_pool_size == 0) {
+        return;
+    }
+    if (pools->installed && lv_draw_buf_get_handlers()->buf_malloc_cb != rgb_panel_layer_malloc) {
+        /* lv_init() ran again after a soft reset: whatever the old LVGL
+         * instance left in the pools is garbage, so start them empty (the
+         * cached glyphs live there too) */
+        rgb_panel_glyphs_drop();
+        rgb_panel_pool_reset(&pools->psram);
+        rgb_panel_pool_reset(&pools->sram);
+        rgb_panel_pools_hook(pools);
+        return;
+    }
+    if (pools->installed) {
+        if (pools->psram.size != self->pool_size || pools->sram.size != self->sram_pool_size) {
+            ESP_LOGW(TAG, "LVGL pools already created (%u + %u bytes), sizes unchanged",
+                     (unsigned)pools->psram.size, (unsigned)pools->sram.size);
+        }
+        return;
+    }
+    if (!rgb_panel_pool_create(&pools->psram, self->pool_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)) {
+        mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no PSRAM for LVGL pool"));
+    }
+    if (!rgb_panel_pool_create(&pools->sram, self->sram_pool_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)) {
+        heap_caps_free(pools->psram.start);    /* nothing allocated from it yet */
+        memset(&pools->psram, 0, sizeof(pools->psram));
+        mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no internal RAM for LVGL pool"));
+    }
+    rgb_panel_pools_hook(pools);
+    ESP_LOGI(TAG, "LVGL draw buffer pools: %u bytes PSRAM, %u bytes SRAM",
+             (unsigned)pools->psram.size, (unsigned)pools->sram.size);
+}
 
 /* ────────────────────────────────────────────────────────────────────────── */
-/*  LVGL tick via esp_timer                                                  */
+/*  Glyph and image caches                                                   */
 /* ────────────────────────────────────────────────────────────────────────── */
 
-static void lv_tick_cb(void *arg) {
-    lv_tick_inc(5);
+/*
+ * LVGL 9.3 caches decoded images and image headers (sized by the board, see
+ * lv_conf.h), but not the glyphs of its built-in bitmap fonts: every label
+ * redraw expands each glyph from the 4 bpp font data into an A8 draw buffer
+ * again.  cached_font(font) returns a RAM copy of a font whose
+ * get_glyph_bitmap keeps the expanded glyphs in a direct-mapped table of
+ * RGB_PANEL_GLYPH_CACHE_ENTRIES slots and copies them out on later draws.
+ * The binding only hands out the const lv_font_montserrat_* structs, so the
+ * UI has to ask for the copy (ui.py casts it with lv.font_t.__cast__()).
+ *
+ * Glyph memory comes from the PSRAM draw buffer pool when there is one.
+ * The bitmap callback runs in the draw units, possibly two at once, so the
+ * table is only touched under a spinlock and never allocates from the GC.
+ * The spinlock masks interrupts, so the PSRAM copies run outside it: a hit
+ * pins its slot for the copy, and a pinned slot is not replaced.
+ */
+#ifndef RGB_PANEL_GLYPH_CACHE_ENTRIES
+#define RGB_PANEL_GLYPH_CACHE_ENTRIES 256
+#endif
+#define RGB_PANEL_GLYPH_FONTS 8
+
+#if RGB_PANEL_GLYPH_CACHE_ENTRIES > 0
+
+typedef struct {
+    uint32_t key;                   /* font number << 24 | glyph index, 0 = empty */
+    uint16_t stride;
+    uint16_t h;
+    uint16_t readers;               /* draw units copying data out, not evictable */
+    uint8_t *data;
+} rgb_panel_glyph_t;
+
+typedef struct {
+    lv_font_t fonts[RGB_PANEL_GLYPH_FONTS];
+    const lv_font_t *orig[RGB_PANEL_GLYPH_FONTS];
+    int n_fonts;
+    rgb_panel_glyph_t *slots;       /* internal RAM, allocated with the first font */
+    portMUX_TYPE lock;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t used;
+    size_t bytes;
+} rgb_panel_glyphs_t;
+
+static rgb_panel_glyphs_t rgb_panel_glyphs = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static uint8_t *rgb_panel_glyph_alloc(size_t size) {
+    uint8_t *p = rgb_panel_pool_alloc(&rgb_panel_pools.psram, size);
+    return p != NULL ? p : heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+static void rgb_panel_glyph_free(uint8_t *p) {
+    if (rgb_panel_pool_owns(&rgb_panel_pools.psram, p)) {
+        multi_heap_free(rgb_panel_pools.psram.heap, p);
+    } else {
+        heap_caps_free(p);
+    }
+}
+
+static const void *rgb_panel_glyph_bitmap(lv_font_glyph_dsc_t *g, lv_draw_buf_t *draw_buf) {
+    rgb_panel_glyphs_t *gc = &rgb_panel_glyphs;
+    int font = g->resolved_font - gc->fonts;
+    const lv_font_t *orig = gc->orig[font];
+    if (draw_buf == NULL) {
+        return orig->get_glyph_bitmap(g, draw_buf);
+    }
+
+    uint32_t key = ((uint32_t)(font + 1) << 24) | (g->gid.index & 0xFFFFFF);
+    rgb_panel_glyph_t *slot = &gc->slots[(key * 2654435761U) % RGB_PANEL_GLYPH_CACHE_ENTRIES];
+    uint32_t stride = draw_buf->header.stride;
+    size_t len = (size_t)stride * g->box_h;
+
+    taskENTER_CRITICAL(&gc->lock);
+    bool hit = slot->key == key && slot->stride == stride && slot->h == g->box_h && len <= draw_buf->data_size;
+    const uint8_t *data = slot->data;
+    if (hit) {
+        slot->readers++;
+        gc->hits++;
+    } else {
+        gc->misses++;
+    }
+    taskEXIT_CRITICAL(&gc->lock);
+    if (hit) {
+        memcpy(draw_buf->data, data, len);
+        taskENTER_CRITICAL(&gc->lock);
+        slot->readers--;
+        taskEXIT_CRITICAL(&gc->lock);
+        return draw_buf;
+    }
+
+    /* Bitmaps handed out in place (not expanded into draw_buf) stay uncached */
+    const void *res = orig->get_glyph_bitmap(g, draw_buf);
+    if (res != draw_buf || len == 0 || stride > UINT16_MAX) {
+        return res;
+    }
+    uint8_t *copy = rgb_panel_glyph_alloc(len);
+    if (copy == NULL) {
+        return res;
+    }
+    memcpy(copy, draw_buf->data, len);
+
+    uint8_t *old = NULL;
+    taskENTER_CRITICAL(&gc->lock);
+    if (slot->readers != 0) {
+        /* Another draw unit is copying the current entry out: keep it */
+        taskEXIT_CRITICAL(&gc->lock);
+        rgb_panel_glyph_free(copy);
+        return res;
+    }
+    if (slot->key != 0) {
+        old = slot->data;
+        gc->bytes -= (size_t)slot->stride * slot->h;
+        gc->evictions++;
+    } else {
+        gc->used++;
+    }
+    slot->key = key;
+    slot->stride = (uint16_t)stride;
+    slot->h = g->box_h;
+    slot->data = copy;
+    gc->bytes += len;
+    taskEXIT_CRITICAL(&gc->lock);
+
+    if (old != NULL) {
+        rgb_panel_glyph_free(old);
+    }
+    return res;
+}
+
+#endif /* RGB_PANEL_GLYPH_CACHE_ENTRIES > 0 */
+
+/* Empty the glyph table; the cached fonts stay valid and refill it */
+static void rgb_panel_glyphs_drop(void) {
+    #if RGB_PANEL_GLYPH_CACHE_ENTRIES > 0
+    rgb_panel_glyphs_t *gc = &rgb_panel_glyphs;
+    for (int i = 0; gc->slots != NULL && i < RGB_PANEL_GLYPH_CACHE_ENTRIES; i++) {
+        if (gc->slots[i].key != 0) {
+            rgb_panel_glyph_free(gc->slots[i].data);
+            gc->slots[i].key = 0;
+        }
+    }
+    gc->used = 0;
+    gc->bytes = 0;
+    #endif
+}
+
+/*
+ * Image and header cache hit counters: both caches are lv_cache_t objects
+ * created by lv_init(); their class is swapped for a copy whose get_cb
+ * counts the lookups.  get_cb runs under the cache's own lock.
+ */
+enum { RGB_PANEL_CACHE_IMAGE, RGB_PANEL_CACHE_HEADER, RGB_PANEL_CACHE_COUNT };
+
+typedef struct {
+    lv_cache_class_t clz;
+    const lv_cache_class_t *orig;
+    lv_cache_t *cache;
+    uint32_t hits;
+    uint32_t misses;
+} rgb_panel_cache_probe_t;
+
+static rgb_panel_cache_probe_t rgb_panel_cache_probes[RGB_PANEL_CACHE_COUNT];
+
+static lv_cache_entry_t *rgb_panel_cache_get(lv_cache_t *cache, const void *key, void *user_data) {
+    rgb_panel_cache_probe_t *p = &rgb_panel_cache_probes[RGB_PANEL_CACHE_IMAGE];
+    if (cache != p->cache) {
+        p = &rgb_panel_cache_probes[RGB_PANEL_CACHE_HEADER];
+    }
+    lv_cache_entry_t *entry = p->orig->get_cb(cache, key, user_data);
+    if (entry != NULL) {
+        p->hits++;
+    } else {
+        p->misses++;
+    }
+    return entry;
+}
+
+/* Hook the caches of the current lv_init() (again after lv_deinit()) */
+static void rgb_panel_cache_probes_install(void) {
+    lv_cache_t *caches[RGB_PANEL_CACHE_COUNT] = {
+        LV_GLOBAL_DEFAULT()->img_cache, LV_GLOBAL_DEFAULT()->img_header_cache,
+    };
+    for (int i = 0; i < RGB_PANEL_CACHE_COUNT; i++) {
+        rgb_panel_cache_probe_t *p = &rgb_panel_cache_probes[i];
+        lv_cache_t *cache = caches[i];
+        if (cache == NULL || cache->clz == &p->clz) {
+            continue;
+        }
+        p->orig = cache->clz;
+        p->clz = *cache->clz;
+        p->clz.get_cb = rgb_panel_cache_get;
+        p->cache = cache;
+        p->hits = p->misses = 0;
+        cache->clz = &p->clz;
+    }
 }
 
+#if MICROPY_HW_RGB_PANEL_SPI_INIT
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  SPI 3-wire bit-bang (9-bit mode)                                         */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -137,17 +993,137 @@ static void lcd_data(rgb_panel_obj_t *self, uint8_t data) {
     spi_write_9bit(self, true, data);
 }
 
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  SPI 3-wire on the SPI2 peripheral                                        */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * The SPI master can clock out any number of bits, so the 9-bit words of one
+ * command and its parameters are packed into a single bitstream and sent as
+ * one transaction, CS held low throughout.  Mode 3 matches the bit-bang.
+ */
+static bool spi_hw_open(rgb_panel_obj_t *self) {
+    spi_bus_config_t bus = {
+        .mosi_io_num = self->spi_mosi,
+        .miso_io_num = -1,
+        .sclk_io_num = self->spi_clk,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = RGB_PANEL_SPI_MAX_TX,
+    };
+    esp_err_t err = spi_bus_initialize(RGB_PANEL_SPI_HOST, &bus, SPI_DMA_CH_AUTO);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "SPI bus init failed (%s), bit-banging panel init", esp_err_to_name(err));
+        return false;
+    }
+
+    spi_device_interface_config_t dev = {
+        .mode = 3,
+        .clock_speed_hz = self->spi_freq,
+        .spics_io_num = self->spi_cs,
+        .queue_size = 1,
+    };
+    err = spi_bus_add_device(RGB_PANEL_SPI_HOST, &dev, &self->spi_dev);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "SPI device add failed (%s), bit-banging panel init", esp_err_to_name(err));
+        spi_bus_free(RGB_PANEL_SPI_HOST);
+        self->spi_dev = NULL;
+        return false;
+    }
+    return true;
+}
+
+/* Release the bus once the panel is programmed; it is not needed again */
+static void spi_hw_close(rgb_panel_obj_t *self) {
+    if (self->spi_dev == NULL) return;
+    spi_bus_remove_device(self->spi_dev);
+    spi_bus_free(RGB_PANEL_SPI_HOST);
+    self->spi_dev = NULL;
+}
+
+/* Append one D/C-flagged 9-bit word to a zeroed bitstream, MSB first */
+static size_t spi_pack_9bit(uint8_t *buf, size_t bitpos, bool is_data, uint8_t val) {
+    uint16_t word = (is_data ? 0x100 : 0) | val;
+    for (int i = 8; i >= 0; i--, bitpos++) {
+        if (word & (1 << i)) {
+            buf[bitpos >> 3] |= 0x80 >> (bitpos & 7);
+        }
+    }
+    return bitpos;
+}
+
+static bool spi_hw_send(rgb_panel_obj_t *self, uint8_t cmd, const uint8_t *data, size_t len) {
+    WORD_ALIGNED_ATTR uint8_t buf[RGB_PANEL_SPI_MAX_TX];
+    if ((len + 1) * 9 > sizeof(buf) * 8) return false;
+
+    memset(buf, 0, sizeof(buf));
+    size_t bits = spi_pack_9bit(buf, 0, false, cmd);
+    for (size_t i = 0; i < len; i++) {
+        bits = spi_pack_9bit(buf, bits, true, data[i]);
+    }
+
+    spi_transaction_t t = {
+        .length = bits,
+        .tx_buffer = buf,
+    };
+    return spi_device_polling_transmit(self->spi_dev, &t) == ESP_OK;
+}
+
+/* Send one command with its parameters on whichever backend is active */
+static void lcd_send(rgb_panel_obj_t *self, uint8_t cmd, const uint8_t *data, size_t len) {
+    if (self->spi_dev != NULL && spi_hw_send(self, cmd, data, len)) {
+        return;
+    }
+    lcd_cmd(self, cmd);
+    for (size_t i = 0; i < len; i++) {
+        lcd_data(self, data[i]);
+    }
+}
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Data-driven panel init from Python list                                  */
 /* ────────────────────────────────────────────────────────────────────────── */
 
 /*
- * init_cmds is a Python list of tuples: [(cmd, [data...] or None, delay_ms), ...]
+ * init_cmds is either
+ *  - a Python list of tuples: [(cmd, [data...] or None, delay_ms), ...], or
+ *  - a bytes-like blob of packed records, one per command:
+ *        cmd:u8  len:u8  data[len]  delay_ms:u8
+ *    as produced by firmware/tools/pack_init_cmds.py.  A frozen bytes
+ *    constant stays in flash, so nothing is decoded or allocated at boot.
  * Iterates through and sends each command via SPI 3-wire.
  */
+#define RGB_PANEL_INIT_MAX_DATA 64  /* longer parameter lists are heap-allocated */
+
+static void run_init_blob(rgb_panel_obj_t *self, const uint8_t *blob, size_t len) {
+    /* Validate first so a truncated blob never half-programs the panel */
+    size_t pos = 0;
+    while (pos < len) {
+        if (pos + 2 > len || pos + 3 + blob[pos + 1] > len) {
+            mp_raise_ValueError(MP_ERROR_TEXT("truncated init_cmds blob"));
+        }
+        pos += 3 + blob[pos + 1];
+    }
+
+    for (pos = 0; pos < len; pos += 3 + blob[pos + 1]) {
+        uint8_t data_len = blob[pos + 1];
+        lcd_send(self, blob[pos], &blob[pos + 2], data_len);
+        uint8_t delay_ms = blob[pos + 2 + data_len];
+        if (delay_ms > 0) {
+            vTaskDelay(pdMS_TO_TICKS(delay_ms));
+        }
+    }
+}
+
 static void run_init_cmds(rgb_panel_obj_t *self) {
     if (self->init_cmds == mp_const_none) return;
 
+    mp_buffer_info_t bufinfo;
+    if (mp_get_buffer(self->init_cmds, &bufinfo, MP_BUFFER_READ)) {
+        run_init_blob(self, bufinfo.buf, bufinfo.len);
+        return;
+    }
+
     mp_obj_t *items;
     size_t len;
     mp_obj_get_array(self->init_cmds, &len, &items);
@@ -159,17 +1135,25 @@ static void run_init_cmds(rgb_panel_obj_t *self) {
 
         /* Command byte */
         uint8_t cmd = mp_obj_get_int(entry[0]);
-        lcd_cmd(self, cmd);
 
         /* Data bytes (entry[1] may be None or a list) */
+        uint8_t stack_buf[RGB_PANEL_INIT_MAX_DATA];
+        uint8_t *buf = stack_buf;
+        size_t data_len = 0;
         if (entry_len > 1 && entry[1] != mp_const_none) {
             mp_obj_t *data;
-            size_t data_len;
             mp_obj_get_array(entry[1], &data_len, &data);
+            if (data_len > sizeof(stack_buf)) {
+                buf = m_new(uint8_t, data_len);
+            }
             for (size_t j = 0; j < data_len; j++) {
-                lcd_data(self, mp_obj_get_int(data[j]));
+                buf[j] = mp_obj_get_int(data[j]);
             }
         }
+        lcd_send(self, cmd, buf, data_len);
+        if (buf != stack_buf) {
+            m_del(uint8_t, buf, data_len);
+        }
 
         /* Delay (entry[2] in ms, 0 = no delay) */
         if (entry_len > 2) {
@@ -181,10 +1165,13 @@ static void run_init_cmds(rgb_panel_obj_t *self) {
     }
 }
 
+#endif /* MICROPY_HW_RGB_PANEL_SPI_INIT */
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  GPIO setup                                                               */
 /* ────────────────────────────────────────────────────────────────────────── */
 
+#if MICROPY_HW_RGB_PANEL_SPI_INIT
 static void setup_spi_pins(rgb_panel_obj_t *self) {
     gpio_config_t io_conf = {
         .mode = GPIO_MODE_OUTPUT,
@@ -201,9 +1188,9 @@ static void setup_spi_pins(rgb_panel_obj_t *self) {
     gpio_set_level(self->spi_clk, 1);
     gpio_set_level(self->spi_cs, 1);
 }
+#endif
 
-static void setup_backlight(rgb_panel_obj_t *self) {
-    if (self->backlight < 0) return;
+static void setup_backlight_gpio(rgb_panel_obj_t *self) {
     gpio_config_t io_conf = {
         .pin_bit_mask = (1ULL << self->backlight),
         .mode = GPIO_MODE_OUTPUT,
@@ -214,17 +1201,204 @@ static void setup_backlight(rgb_panel_obj_t *self) {
     gpio_config(&io_conf);
 }
 
-/* ────────────────────────────────────────────────────────────────────────── */
-/*  RGB panel setup via esp_lcd                                              */
-/* ────────────────────────────────────────────────────────────────────────── */
-
-static esp_err_t setup_rgb_panel(rgb_panel_obj_t *self) {
-    esp_lcd_rgb_panel_config_t panel_config = {
-        .clk_src = LCD_CLK_SRC_DEFAULT,
+/*
+ * With backlight_freq the pin is an LEDC channel and brightness changes fade
+ * in hardware (the LEDC fade ISR steps the duty, no task involved).  If LEDC
+ * cannot be set up the backlight falls back to on/off.
+ */
+static void setup_backlight(rgb_panel_obj_t *self) {
+    if (self->backlight < 0) return;
+    if (self->bl_freq == 0) {
+        setup_backlight_gpio(self);
+        return;
+    }
+    ledc_timer_config_t timer = {
+        .speed_mode = RGB_PANEL_BL_LEDC_MODE,
+        .duty_resolution = RGB_PANEL_BL_DUTY_BITS,
+        .timer_num = RGB_PANEL_BL_LEDC_TIMER,
+        .freq_hz = self->bl_freq,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    ledc_channel_config_t channel = {
+        .gpio_num = self->backlight,
+        .speed_mode = RGB_PANEL_BL_LEDC_MODE,
+        .channel = RGB_PANEL_BL_LEDC_CHANNEL,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = RGB_PANEL_BL_LEDC_TIMER,
+        .duty = 0,
+        .hpoint = 0,
+    };
+    esp_err_t err = ledc_timer_config(&timer);
+    if (err == ESP_OK) {
+        err = ledc_channel_config(&channel);
+    }
+    if (err == ESP_OK) {
+        /* Installed once for the whole firmware, possibly by someone else */
+        err = ledc_fade_func_install(0);
+        if (err == ESP_ERR_INVALID_STATE) {
+            err = ESP_OK;
+        }
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Backlight PWM disabled: %s", esp_err_to_name(err));
+        self->bl_freq = 0;
+        setup_backlight_gpio(self);
+    }
+}
+
+/* Backlight to level % over fade_ms (PWM only; on/off switches at once) */
+static void rgb_panel_bl_set(rgb_panel_obj_t *self, uint32_t level, uint32_t fade_ms) {
+    self->bl_level = (uint8_t)level;
+    if (self->backlight < 0) return;
+    if (self->bl_freq == 0) {
+        gpio_set_level(self->backlight, level > 0 ? 1 : 0);
+        return;
+    }
+    uint32_t duty = (level * ((1u << RGB_PANEL_BL_DUTY_BITS) - 1) + 50) / 100;
+    if (fade_ms > 0) {
+        ledc_set_fade_time_and_start(RGB_PANEL_BL_LEDC_MODE, RGB_PANEL_BL_LEDC_CHANNEL, duty, fade_ms,
+                                     LEDC_FADE_NO_WAIT);
+    } else {
+        ledc_set_duty_and_update(RGB_PANEL_BL_LEDC_MODE, RGB_PANEL_BL_LEDC_CHANNEL, duty, 0);
+    }
+}
+
+/* Close one boot-profiling stage: time since the previous mark */
+static void rgb_panel_boot_mark(rgb_panel_obj_t *self, int stage) {
+    int64_t now = esp_timer_get_time();
+    self->boot_us[stage] = (uint32_t)(now - self->boot_mark_us);
+    self->boot_mark_us = now;
+}
+
+/* esp_lcd rejects asking for more framebuffers than the panel has */
+static void rgb_panel_get_fbs(rgb_panel_obj_t *self, void **fb0, void **fb1) {
+    *fb0 = NULL;
+    *fb1 = NULL;
+    if (self->num_fbs == 2) {
+        esp_lcd_rgb_panel_get_frame_buffer(self->panel_handle, 2, fb0, fb1);
+    } else {
+        esp_lcd_rgb_panel_get_frame_buffer(self->panel_handle, 1, fb0);
+    }
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  RGB panel setup via esp_lcd                                              */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/* The buffer queued by draw_bitmap() is now the one being scanned out */
+static IRAM_ATTR bool rgb_panel_swap_latched(rgb_panel_isr_ctx_t *isr, int64_t now) {
+    if (!isr->swap_pending) return false;
+    isr->swap_latched_us = now;
+    isr->swap_pending = 0;
+    if (isr->swaps++ == 0) {
+        isr->first_swap_us = now;
+    }
+    rgb_panel_trace_at(RGB_PANEL_TRACE_SWAP, isr->swaps, (uint32_t)now);
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(isr->swap_done, &woken);
+    return woken == pdTRUE;
+}
+
+/*
+ * Called on every VSYNC.  Without bounce buffers the LCD DMA is restarted on
+ * the queued framebuffer here, so this is also where a swap takes effect.
+ */
+static IRAM_ATTR bool rgb_panel_on_vsync(esp_lcd_panel_handle_t panel,
+                                         const esp_lcd_rgb_panel_event_data_t *edata,
+                                         void *user_ctx) {
+    rgb_panel_isr_ctx_t *isr = (rgb_panel_isr_ctx_t *)user_ctx;
+    int64_t now = esp_timer_get_time();
+
+    if (isr->last_vsync_us != 0) {
+        int32_t dt = (int32_t)(now - isr->last_vsync_us);
+        int32_t avg = (int32_t)isr->frame_avg_us;
+        isr->frame_avg_us = (uint32_t)(avg + (dt - avg) / 8);
+    }
+    isr->last_vsync_us = now;
+    isr->frames++;
+
+    if (isr->bb_deadline_us == 0) {               /* no bounce buffers */
+        return rgb_panel_swap_latched(isr, now);
+    }
+    return false;
+}
+
+#if MICROPY_HW_RGB_PANEL_BOUNCE
+/*
+ * Called by the esp_lcd ISR each time the bounce buffers have pushed a whole
+ * frame out.  Refills for the next frame read from the queued framebuffer, so
+ * with bounce buffers this is where a swap takes effect.  A refill that
+ * misses its deadline shows up as a frame finishing later than the nominal
+ * period by more than one bounce buffer's drain time: the refill shares this
+ * interrupt, so it was held off for at least as long.
+ */
+static IRAM_ATTR bool rgb_panel_on_bounce_frame_finish(esp_lcd_panel_handle_t panel,
+                                                       const esp_lcd_rgb_panel_event_data_t *edata,
+                                                       void *user_ctx) {
+    rgb_panel_isr_ctx_t *isr = (rgb_panel_isr_ctx_t *)user_ctx;
+    int64_t now = esp_timer_get_time();
+
+    if (isr->bb_last_frame_us != 0) {
+        int64_t late = (now - isr->bb_last_frame_us) - isr->frame_period_us;
+        if (late > (int64_t)isr->bb_deadline_us) {
+            isr->bb_underruns++;
+        }
+    }
+    isr->bb_last_frame_us = now;
+    isr->bb_frames++;
+    return rgb_panel_swap_latched(isr, now);
+}
+#endif
+
+/*
+ * esp_lcd allocates the RGB interrupt on the core that creates the panel, so
+ * pinning the bounce-buffer refill ISR means creating the panel from a task
+ * pinned to that core.
+ */
+typedef struct {
+    const esp_lcd_rgb_panel_config_t *config;
+    esp_lcd_panel_handle_t *handle;
+    esp_err_t err;
+    SemaphoreHandle_t done;
+} rgb_panel_create_job_t;
+
+static void rgb_panel_create_task(void *arg) {
+    rgb_panel_create_job_t *job = (rgb_panel_create_job_t *)arg;
+    job->err = esp_lcd_new_rgb_panel(job->config, job->handle);
+    xSemaphoreGive(job->done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t rgb_panel_create(rgb_panel_obj_t *self, const esp_lcd_rgb_panel_config_t *config) {
+    if (self->bb_core < 0) {
+        return esp_lcd_new_rgb_panel(config, &self->panel_handle);
+    }
+
+    rgb_panel_create_job_t job = {
+        .config = config,
+        .handle = &self->panel_handle,
+        .err = ESP_FAIL,
+        .done = xSemaphoreCreateBinary(),
+    };
+    if (job.done == NULL) return ESP_ERR_NO_MEM;
+
+    if (xTaskCreatePinnedToCore(rgb_panel_create_task, "rgb_create", 4096, &job,
+                                configMAX_PRIORITIES - 1, NULL, self->bb_core) != pdPASS) {
+        vSemaphoreDelete(job.done);
+        return ESP_ERR_NO_MEM;
+    }
+    xSemaphoreTake(job.done, portMAX_DELAY);
+    vSemaphoreDelete(job.done);
+    return job.err;
+}
+
+static esp_err_t setup_rgb_panel(rgb_panel_obj_t *self) {
+    esp_lcd_rgb_panel_config_t panel_config = {
+        .clk_src = LCD_CLK_SRC_DEFAULT,
         .timings = {
             .pclk_hz = self->pclk_freq,
-            .h_res = self->width,
-            .v_res = self->height,
+            .h_res = RGB_PANEL_WIDTH(self),
+            .v_res = RGB_PANEL_HEIGHT(self),
             .hsync_pulse_width = self->hsync_pulse_width,
             .hsync_back_porch = self->hsync_back_porch,
             .hsync_front_porch = self->hsync_front_porch,
@@ -239,8 +1413,8 @@ static esp_err_t setup_rgb_panel(rgb_panel_obj_t *self) {
         },
         .data_width = 16,
         .bits_per_pixel = 16,
-        .num_fbs = 2,           /* double-buffered for LVGL DIRECT mode */
-        .bounce_buffer_size_px = 0,  /* no bounce buffers */
+        .num_fbs = self->num_fbs,   /* 2 for LVGL DIRECT mode, 1 for PARTIAL */
+        .bounce_buffer_size_px = (size_t)RGB_PANEL_WIDTH(self) * RGB_PANEL_BB_LINES(self),
         .sram_trans_align = 8,
         .psram_trans_align = 64,
         .hsync_gpio_num = self->hsync,
@@ -259,17 +1433,49 @@ static esp_err_t setup_rgb_panel(rgb_panel_obj_t *self) {
         },
     };
 
-    ESP_ERROR_CHECK(esp_lcd_new_rgb_panel(&panel_config, &self->panel_handle));
+    ESP_ERROR_CHECK(rgb_panel_create(self, &panel_config));
+    rgb_panel_boot_mark(self, RGB_PANEL_BOOT_PANEL_CREATE);
+
+    rgb_panel_isr_ctx_t *isr = self->isr;
+    uint32_t h_total = RGB_PANEL_WIDTH(self) + self->hsync_pulse_width +
+                       self->hsync_back_porch + self->hsync_front_porch;
+    uint32_t v_total = RGB_PANEL_HEIGHT(self) + self->vsync_pulse_width +
+                       self->vsync_back_porch + self->vsync_front_porch;
+    isr->frame_period_us = (uint32_t)((uint64_t)h_total * v_total * 1000000 / self->pclk_freq);
+    isr->frame_avg_us = isr->frame_period_us;
+    isr->last_vsync_us = 0;
+    isr->frames = 0;
+    isr->swap_pending = 0;
+    isr->swaps = 0;
+    isr->first_swap_us = 0;
+
+    esp_lcd_rgb_panel_event_callbacks_t cbs = {
+        .on_vsync = rgb_panel_on_vsync,
+    };
+    #if MICROPY_HW_RGB_PANEL_BOUNCE
+    if (RGB_PANEL_BB_LINES(self) > 0) {
+        isr->bb_deadline_us = (uint32_t)((uint64_t)h_total * RGB_PANEL_BB_LINES(self) * 1000000 / self->pclk_freq);
+        cbs.on_bounce_frame_finish = rgb_panel_on_bounce_frame_finish;
+    }
+    #endif
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(self->panel_handle, &cbs, isr));
+
     ESP_ERROR_CHECK(esp_lcd_panel_reset(self->panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_init(self->panel_handle));
+    rgb_panel_boot_mark(self, RGB_PANEL_BOOT_PANEL_INIT);
 
-    /* Retrieve both framebuffer pointers */
+    /* Retrieve the framebuffer pointers (fb1 stays NULL in PARTIAL mode) */
     void *fb0 = NULL, *fb1 = NULL;
-    esp_lcd_rgb_panel_get_frame_buffer(self->panel_handle, 2, &fb0, &fb1);
+    rgb_panel_get_fbs(self, &fb0, &fb1);
     self->framebuffer = (uint16_t *)fb0;
 
     ESP_LOGI(TAG, "RGB panel ready: %dx%d, fb0=%p, fb1=%p",
-             self->width, self->height, fb0, fb1);
+             RGB_PANEL_WIDTH(self), RGB_PANEL_HEIGHT(self), fb0, fb1);
+    if (RGB_PANEL_BB_LINES(self) > 0) {
+        ESP_LOGI(TAG, "Bounce buffers: 2x%d lines (%u bytes SRAM), core %d",
+                 RGB_PANEL_BB_LINES(self), (unsigned)(2 * panel_config.bounce_buffer_size_px * sizeof(uint16_t)),
+                 self->bb_core);
+    }
     return ESP_OK;
 }
 
@@ -288,244 +1494,2542 @@ static esp_err_t setup_rgb_panel(rgb_panel_obj_t *self) {
  *
  * On the last dirty area we also tell the RGB peripheral to swap which buffer
  * it scans out, giving tear-free updates.
+ *
+ * The copy is not done per area.  Flushed areas are collected for the frame
+ * and merged into a few non-overlapping rectangles so every pixel is copied
+ * once, even when the header, status bar and labels invalidate together.
+ * The copy starts as soon as the swap has latched (the stale buffer is off
+ * screen from then on), at the start of the next refresh, so the DMA bands
+ * run while LVGL updates layout and joins areas.  LV_EVENT_RENDER_START,
+ * right before LVGL draws into the stale buffer, only waits for them.
+ *
+ * The swap itself only takes effect at the next VSYNC (or bounce-buffer frame
+ * end), and until then the "stale" buffer is still being scanned out.  So
+ * flush-ready for the last area is deferred until the VSYNC ISR reports the
+ * new buffer latched; nothing writes the old one before that.
  */
-static void rgb_panel_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
-    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_display_get_user_data(disp);
-
-    /* Get both framebuffer pointers from the RGB panel */
-    void *fb0 = NULL, *fb1 = NULL;
-    esp_lcd_rgb_panel_get_frame_buffer(self->panel_handle, 2, &fb0, &fb1);
-
-    /* px_map is the buffer LVGL just rendered into; other_buf is the stale one */
-    uint8_t *other_buf = (px_map == (uint8_t *)fb0) ? (uint8_t *)fb1 : (uint8_t *)fb0;
 
-    /* Copy the dirty area from source to dest buffer (row by row) */
+/* Copy one dirty area from src to dst framebuffer on the CPU (row by row) */
+static void rgb_panel_copy_area(rgb_panel_obj_t *self, uint8_t *dst, const uint8_t *src,
+                                const lv_area_t *area) {
     int32_t x1 = area->x1;
     int32_t y1 = area->y1;
     int32_t w = lv_area_get_width(area);
     int32_t h = lv_area_get_height(area);
-    size_t stride = (size_t)self->width * sizeof(uint16_t);  /* bytes per row */
-    size_t row_bytes = (size_t)w * sizeof(uint16_t);
+    size_t stride = RGB_PANEL_STRIDE(self);      /* bytes per row */
+    size_t offset = (size_t)y1 * stride + (size_t)x1 * sizeof(uint16_t);
 
-    for (int32_t y = y1; y < y1 + h; y++) {
-        size_t offset = (size_t)y * stride + (size_t)x1 * sizeof(uint16_t);
-        memcpy(other_buf + offset, px_map + offset, row_bytes);
+    /* Full-width bands are contiguous: one long row, one alignment prologue */
+    if (w == RGB_PANEL_WIDTH(self)) {
+        w *= h;
+        h = 1;
     }
 
-    /* On the last dirty area, swap the displayed buffer */
-    if (lv_display_flush_is_last(disp)) {
-        esp_lcd_panel_draw_bitmap(self->panel_handle, 0, 0,
-                                  self->width, self->height, px_map);
-    }
+    /* Strided RGB565 rows: the PIE blit kernel on ESP32-S3 */
+    rgb565_pie_copy((uint16_t *)(dst + offset), (int32_t)stride,
+                    (const uint16_t *)(src + offset), (int32_t)stride, w, h);
+}
 
-    lv_display_flush_ready(disp);
+/*
+ * Async memcpy path.  GDMA wants PSRAM addresses and lengths aligned to the
+ * external-memory block size, which whole framebuffer rows are (the stride is
+ * a multiple of 64 bytes and the buffers are 64-byte aligned).  So each dirty
+ * area is widened to a full-row band and sent as one contiguous transaction.
+ * That is safe because the rendered buffer holds the complete current frame,
+ * not just the dirty pixels.
+ */
+static IRAM_ATTR bool rgb_panel_copy_done_cb(async_memcpy_handle_t mcp, async_memcpy_event_t *event,
+                                             void *user_ctx) {
+    rgb_panel_isr_ctx_t *isr = (rgb_panel_isr_ctx_t *)user_ctx;
+    BaseType_t woken = pdFALSE;
+    if (__atomic_sub_fetch(&isr->copies_pending, 1, __ATOMIC_SEQ_CST) == 0) {
+        xSemaphoreGiveFromISR(isr->copy_done, &woken);
+    }
+    return woken == pdTRUE;
 }
 
-/* ────────────────────────────────────────────────────────────────────────── */
-/*  LVGL display registration                                                */
-/* ────────────────────────────────────────────────────────────────────────── */
+/* Block (yielding to other tasks) until all queued DMA copies have landed */
+static void rgb_panel_copy_wait(rgb_panel_obj_t *self) {
+    if (self->mcp == NULL) return;
+    rgb_panel_isr_ctx_t *isr = self->isr;
+    while (__atomic_load_n(&isr->copies_pending, __ATOMIC_SEQ_CST) != 0) {
+        MP_THREAD_GIL_EXIT();
+        xSemaphoreTake(isr->copy_done, pdMS_TO_TICKS(100));
+        MP_THREAD_GIL_ENTER();
+    }
 
-static void setup_lvgl_display(rgb_panel_obj_t *self) {
-    /* Get both framebuffer pointers */
-    void *fb0 = NULL, *fb1 = NULL;
-    esp_lcd_rgb_panel_get_frame_buffer(self->panel_handle, 2, &fb0, &fb1);
+    /* Drop any cache lines the CPU may have pulled in over the DMA'd rows.
+     * Written back first: CPU-copied rectangles can sit between DMA bands. */
+    if (self->copy_y1 <= self->copy_y2) {
+        void *fb0 = NULL, *fb1 = NULL;
+        rgb_panel_get_fbs(self, &fb0, &fb1);
+        size_t stride = RGB_PANEL_STRIDE(self);
+        size_t offset = (size_t)self->copy_y1 * stride;
+        size_t len = (size_t)(self->copy_y2 - self->copy_y1 + 1) * stride;
+        esp_cache_msync((uint8_t *)fb0 + offset, len,
+                        ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
+        if (fb1 != NULL) {
+            esp_cache_msync((uint8_t *)fb1 + offset, len,
+                            ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
+        }
+        self->copy_y1 = INT32_MAX;
+        self->copy_y2 = -1;
+    }
+}
 
-    lv_display_t *disp = lv_display_create(self->width, self->height);
-    lv_display_set_user_data(disp, self);
-    lv_display_set_flush_cb(disp, rgb_panel_flush_cb);
+/*
+ * Queue rows y1..y2 of a framebuffer for DMA from src (len bytes, already
+ * pointing at row y1).  Returns false if the copy must go via the CPU.
+ */
+static bool rgb_panel_dma_rows(rgb_panel_obj_t *self, uint8_t *dst, uint8_t *src, size_t len,
+                               int32_t y1, int32_t y2) {
+    rgb_panel_isr_ctx_t *isr = self->isr;
 
-    /* DIRECT mode: LVGL draws directly into the panel framebuffer.
-     * Two framebuffers enable tear-free updates. */
-    size_t fb_size = (size_t)self->width * self->height * sizeof(uint16_t);
-    lv_display_set_buffers(disp, fb0, fb1, fb_size, LV_DISPLAY_RENDER_MODE_DIRECT);
-    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    /* DMA reads memory, not the cache: write back what LVGL rendered, and
+     * write back + drop the destination rows so no dirty line is evicted on
+     * top of the DMA'd data later.  Internal SRAM is not cached. */
+    if (esp_ptr_external_ram(src)) {
+        esp_cache_msync(src, len, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+    }
+    esp_cache_msync(dst, len, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
 
-    self->lv_disp = disp;
+    __atomic_add_fetch(&isr->copies_pending, 1, __ATOMIC_SEQ_CST);
+    esp_err_t err = esp_async_memcpy(self->mcp, dst, src, len, rgb_panel_copy_done_cb, isr);
+    if (err == ESP_ERR_INVALID_STATE) {
+        /* Backlog full — drain it and retry once */
+        __atomic_sub_fetch(&isr->copies_pending, 1, __ATOMIC_SEQ_CST);
+        rgb_panel_copy_wait(self);
+        __atomic_add_fetch(&isr->copies_pending, 1, __ATOMIC_SEQ_CST);
+        err = esp_async_memcpy(self->mcp, dst, src, len, rgb_panel_copy_done_cb, isr);
+    }
+    if (err != ESP_OK) {
+        __atomic_sub_fetch(&isr->copies_pending, 1, __ATOMIC_SEQ_CST);
+        return false;
+    }
 
-    /* Start LVGL tick timer (5ms periodic) */
-    esp_timer_create_args_t tick_args = {
-        .callback = lv_tick_cb,
-        .name = "lv_tick",
-    };
-    ESP_ERROR_CHECK(esp_timer_create(&tick_args, &self->tick_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(self->tick_timer, 5000));
+    if (y1 < self->copy_y1) self->copy_y1 = y1;
+    if (y2 > self->copy_y2) self->copy_y2 = y2;
+    return true;
+}
 
-    ESP_LOGI(TAG, "LVGL display registered: %dx%d DIRECT mode, tick=5ms",
-             self->width, self->height);
+/* Queue one full-row band between framebuffers */
+static bool rgb_panel_copy_rows_async(rgb_panel_obj_t *self, uint8_t *dst, uint8_t *src,
+                                      const lv_area_t *area) {
+    size_t stride = RGB_PANEL_STRIDE(self);
+    size_t offset = (size_t)area->y1 * stride;
+    size_t len = (size_t)lv_area_get_height(area) * stride;
+    return rgb_panel_dma_rows(self, dst + offset, src + offset, len, area->y1, area->y2);
 }
 
-/* ────────────────────────────────────────────────────────────────────────── */
-/*  MicroPython constructor                                                  */
-/* ────────────────────────────────────────────────────────────────────────── */
+/* ── Dirty-rectangle coalescing ── */
 
-static mp_obj_t rgb_panel_make_new(const mp_obj_type_t *type, size_t n_args,
-                                    size_t n_kw, const mp_obj_t *all_args) {
-    enum {
-        ARG_width, ARG_height,
-        ARG_data_pins,
-        ARG_hsync_pin, ARG_vsync_pin, ARG_de_pin, ARG_pclk_pin,
-        ARG_pclk_freq,
-        ARG_hsync_pulse_width, ARG_hsync_back_porch, ARG_hsync_front_porch,
-        ARG_vsync_pulse_width, ARG_vsync_back_porch, ARG_vsync_front_porch,
-        ARG_spi_scl, ARG_spi_sda, ARG_spi_cs,
-        ARG_backlight,
-        ARG_init_cmds,
-    };
-    static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_width,               MP_ARG_REQUIRED | MP_ARG_INT },
-        { MP_QSTR_height,              MP_ARG_REQUIRED | MP_ARG_INT },
-        { MP_QSTR_data_pins,           MP_ARG_REQUIRED | MP_ARG_OBJ },
-        { MP_QSTR_hsync_pin,           MP_ARG_REQUIRED | MP_ARG_INT },
-        { MP_QSTR_vsync_pin,           MP_ARG_REQUIRED | MP_ARG_INT },
-        { MP_QSTR_de_pin,              MP_ARG_REQUIRED | MP_ARG_INT },
-        { MP_QSTR_pclk_pin,            MP_ARG_REQUIRED | MP_ARG_INT },
-        { MP_QSTR_pclk_freq,           MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 12000000} },
-        { MP_QSTR_hsync_pulse_width,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 8} },
-        { MP_QSTR_hsync_back_porch,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 20} },
-        { MP_QSTR_hsync_front_porch,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
-        { MP_QSTR_vsync_pulse_width,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 8} },
-        { MP_QSTR_vsync_back_porch,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
-        { MP_QSTR_vsync_front_porch,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
-        { MP_QSTR_spi_scl,             MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
-        { MP_QSTR_spi_sda,             MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
-        { MP_QSTR_spi_cs,              MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
-        { MP_QSTR_backlight,           MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
-        { MP_QSTR_init_cmds,           MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
-    };
+static inline uint32_t rgb_panel_area_px(const lv_area_t *a) {
+    return (uint32_t)lv_area_get_width(a) * (uint32_t)lv_area_get_height(a);
+}
 
-    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
-    mp_arg_parse_all_kw_array(n_args, n_kw, all_args,
-                              MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+static inline void rgb_panel_area_join(lv_area_t *res, const lv_area_t *a, const lv_area_t *b) {
+    res->x1 = LV_MIN(a->x1, b->x1);
+    res->y1 = LV_MIN(a->y1, b->y1);
+    res->x2 = LV_MAX(a->x2, b->x2);
+    res->y2 = LV_MAX(a->y2, b->y2);
+}
 
-    rgb_panel_obj_t *self = mp_obj_malloc(rgb_panel_obj_t, &rgb_panel_type);
+/* Overlapping or sharing an edge (touching counts, so neighbours can merge) */
+static inline bool rgb_panel_area_touch(const lv_area_t *a, const lv_area_t *b) {
+    return a->x1 <= b->x2 + 1 && b->x1 <= a->x2 + 1 &&
+           a->y1 <= b->y2 + 1 && b->y1 <= a->y2 + 1;
+}
 
-    self->width = args[ARG_width].u_int;
-    self->height = args[ARG_height].u_int;
+static inline bool rgb_panel_area_overlap(const lv_area_t *a, const lv_area_t *b) {
+    return a->x1 <= b->x2 && b->x1 <= a->x2 && a->y1 <= b->y2 && b->y1 <= a->y2;
+}
 
-    /* Parse data_pins list (must be exactly 16 GPIOs) */
-    mp_obj_t *pin_items;
-    size_t pin_count;
-    mp_obj_get_array(args[ARG_data_pins].u_obj, &pin_count, &pin_items);
-    if (pin_count != 16) {
-        mp_raise_ValueError(MP_ERROR_TEXT("data_pins must have exactly 16 elements"));
-    }
-    for (int i = 0; i < 16; i++) {
-        self->data[i] = mp_obj_get_int(pin_items[i]);
-    }
+/*
+ * Add one flushed area to the frame's rectangle set, keeping the set
+ * non-overlapping.  Overlapping rectangles are replaced by their bounding
+ * box; touching ones only when the box costs no extra pixels.  When the set
+ * is full the area goes into the rectangle whose box grows least.
+ */
+static void rgb_panel_sync_add(rgb_panel_obj_t *self, const lv_area_t *area) {
+    lv_area_t a = *area;
 
-    self->hsync = args[ARG_hsync_pin].u_int;
-    self->vsync = args[ARG_vsync_pin].u_int;
-    self->de = args[ARG_de_pin].u_int;
-    self->pclk = args[ARG_pclk_pin].u_int;
+    /* DMA copies whole rows; widen here so the set stays disjoint in rows */
+    if (self->mcp != NULL && lv_area_get_width(&a) * 2 >= RGB_PANEL_WIDTH(self)) {
+        a.x1 = 0;
+        a.x2 = RGB_PANEL_WIDTH(self) - 1;
+    }
 
-    self->pclk_freq = args[ARG_pclk_freq].u_int;
-    self->hsync_pulse_width = args[ARG_hsync_pulse_width].u_int;
-    self->hsync_back_porch = args[ARG_hsync_back_porch].u_int;
-    self->hsync_front_porch = args[ARG_hsync_front_porch].u_int;
-    self->vsync_pulse_width = args[ARG_vsync_pulse_width].u_int;
-    self->vsync_back_porch = args[ARG_vsync_back_porch].u_int;
-    self->vsync_front_porch = args[ARG_vsync_front_porch].u_int;
+    bool merged;
+    do {
+        merged = false;
+        for (uint8_t i = 0; i < self->sync_count; i++) {
+            lv_area_t *r = &self->sync_rects[i];
+            if (!rgb_panel_area_touch(&a, r)) continue;
 
-    self->spi_cs = args[ARG_spi_cs].u_int;
-    self->spi_clk = args[ARG_spi_scl].u_int;
-    self->spi_mosi = args[ARG_spi_sda].u_int;
+            lv_area_t box;
+            rgb_panel_area_join(&box, &a, r);
+            if (!rgb_panel_area_overlap(&a, r) &&
+                rgb_panel_area_px(&box) > rgb_panel_area_px(&a) + rgb_panel_area_px(r)) {
+                continue;
+            }
 
-    self->backlight = args[ARG_backlight].u_int;
-    self->init_cmds = args[ARG_init_cmds].u_obj;
+            /* Absorb r and rescan: the bigger box may now hit others */
+            a = box;
+            self->sync_rects[i] = self->sync_rects[--self->sync_count];
+            merged = true;
+            break;
+        }
+    } while (merged);
 
-    self->panel_handle = NULL;
-    self->framebuffer = NULL;
-    self->lv_disp = NULL;
-    self->tick_timer = NULL;
+    if (self->sync_count < RGB_PANEL_SYNC_RECTS) {
+        self->sync_rects[self->sync_count++] = a;
+        return;
+    }
 
-    return MP_OBJ_FROM_PTR(self);
+    /* Full: fold into the cheapest rectangle, then re-add to restore the
+     * non-overlap invariant (the set shrinks by one, so this terminates) */
+    uint8_t best = 0;
+    uint32_t best_cost = UINT32_MAX;
+    for (uint8_t i = 0; i < self->sync_count; i++) {
+        lv_area_t box;
+        rgb_panel_area_join(&box, &a, &self->sync_rects[i]);
+        uint32_t cost = rgb_panel_area_px(&box) - rgb_panel_area_px(&self->sync_rects[i]);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = i;
+        }
+    }
+    lv_area_t box;
+    rgb_panel_area_join(&box, &a, &self->sync_rects[best]);
+    self->sync_rects[best] = self->sync_rects[--self->sync_count];
+    rgb_panel_sync_add(self, &box);
 }
 
-/* ────────────────────────────────────────────────────────────────────────── */
-/*  Methods                                                                  */
-/* ────────────────────────────────────────────────────────────────────────── */
+static void rgb_panel_copy_account(rgb_panel_obj_t *self, int64_t t0) {
+    uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+    self->stats[RGB_PANEL_STATS_TOTAL].copy_us += us;
+    self->stats[RGB_PANEL_STATS_WINDOW].copy_us += us;
+}
 
-/* init() — set up hardware, send init sequence, register LVGL display */
-static mp_obj_t rgb_panel_init(mp_obj_t self_in) {
-    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+/*
+ * Copy the collected rectangles into the stale buffer; only once the swap
+ * has latched, as until then it is still scanned out.  Full-row rectangles
+ * go to DMA when available and are left in flight for render start to wait
+ * on; the rest are copied on the CPU meanwhile — the set is disjoint, so a
+ * CPU rectangle never shares a row with a DMA band.
+ */
+static void rgb_panel_sync_run(rgb_panel_obj_t *self) {
+    if (self->sync_count == 0) return;
 
-    /* 1. SPI init (only if SPI pins are configured) */
-    if (self->spi_clk >= 0) {
-        setup_spi_pins(self);
-        run_init_cmds(self);
+    int64_t t0 = esp_timer_get_time();
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < self->sync_count; i++) {
+        const lv_area_t *r = &self->sync_rects[i];
+        bool full_rows = r->x1 == 0 && r->x2 == RGB_PANEL_WIDTH(self) - 1;
+        if (self->mcp != NULL && full_rows &&
+            rgb_panel_copy_rows_async(self, self->sync_dst, self->sync_src, r)) {
+            /* queued */
+        } else {
+            rgb_panel_copy_area(self, self->sync_dst, self->sync_src, r);
+        }
+        bytes += rgb_panel_area_px(r) * sizeof(uint16_t);
     }
 
-    /* 2. Set up the RGB panel with ESP-IDF lcd driver */
-    setup_rgb_panel(self);
+    self->sync_frames++;
+    self->sync_rects_last = self->sync_count;
+    self->sync_bytes_last = bytes;
+    self->sync_bytes_total += bytes;
+    self->sync_count = 0;
+    self->stats[RGB_PANEL_STATS_TOTAL].bytes_copied += bytes;
+    self->stats[RGB_PANEL_STATS_WINDOW].bytes_copied += bytes;
+    rgb_panel_copy_account(self, t0);
+}
 
-    /* 3. Turn on backlight */
-    if (self->backlight >= 0) {
-        setup_backlight(self);
-        gpio_set_level(self->backlight, 1);
+/* Queue-to-latch time of the swap that just landed */
+static void rgb_panel_swap_account(rgb_panel_obj_t *self) {
+    if (self->swap_queued_us == 0) return;
+    uint32_t us = (uint32_t)(self->isr->swap_latched_us - self->swap_queued_us);
+    self->swap_queued_us = 0;
+    for (int i = 0; i < 2; i++) {
+        rgb_panel_stats_t *st = &self->stats[i];
+        st->swaps++;
+        st->swap_us += us;
+        if (us > st->swap_max_us) st->swap_max_us = us;
     }
+}
 
-    /* 4. Register LVGL display driver + start tick timer */
-    setup_lvgl_display(self);
+/*
+ * Block until the last queued buffer is being scanned out.  LVGL always calls
+ * in with the GIL held (lv.task_handler() or the refresh task); it is dropped
+ * while blocked so Python keeps running.
+ */
+static void rgb_panel_swap_wait(rgb_panel_obj_t *self) {
+    rgb_panel_isr_ctx_t *isr = self->isr;
+    if (!isr->swap_pending) {
+        rgb_panel_swap_account(self);
+        return;
+    }
 
-    ESP_LOGI(TAG, "RGB panel init complete");
-    return mp_const_none;
+    /* A few frame periods: if the panel stopped, don't hang LVGL */
+    TickType_t timeout = pdMS_TO_TICKS(4 * isr->frame_period_us / 1000 + 10);
+    MP_THREAD_GIL_EXIT();
+    BaseType_t latched = xSemaphoreTake(isr->swap_done, timeout);
+    MP_THREAD_GIL_ENTER();
+    if (latched != pdTRUE) {
+        isr->swap_pending = 0;
+        self->swap_queued_us = 0;
+        ESP_LOGW(TAG, "VSYNC timeout waiting for buffer swap");
+        return;
+    }
+    rgb_panel_swap_account(self);
 }
-static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_init_obj, rgb_panel_init);
-
-/* deinit() — tear down display */
-static mp_obj_t rgb_panel_deinit(mp_obj_t self_in) {
-    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
 
-    if (self->tick_timer != NULL) {
-        esp_timer_stop(self->tick_timer);
-        esp_timer_delete(self->tick_timer);
-        self->tick_timer = NULL;
+/*
+ * Let the swap queued by the last frame land and release that flush, then
+ * start the sync copy into the buffer that just went off screen
+ */
+static void rgb_panel_swap_finish(rgb_panel_obj_t *self) {
+    if (self->isr->swap_pending) {
+        rgb_panel_swap_wait(self);
+        lv_display_flush_ready(self->lv_disp);
     }
+    rgb_panel_sync_run(self);
+}
 
-    if (self->lv_disp != NULL) {
-        lv_display_delete(self->lv_disp);
-        self->lv_disp = NULL;
+static void rgb_panel_stats_reset(rgb_panel_obj_t *self, int which) {
+    memset(&self->stats[which], 0, sizeof(rgb_panel_stats_t));
+    self->stats[which].since_us = esp_timer_get_time();
+}
+
+/* Per-area flush accounting; t0 is when flush_cb was entered */
+static void rgb_panel_stats_flush(rgb_panel_obj_t *self, const lv_area_t *area,
+                                  bool last, uint32_t copied, int64_t t0) {
+    uint32_t px = rgb_panel_area_px(area);
+    uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+    rgb_panel_trace(RGB_PANEL_TRACE_FLUSH_END, px);
+    for (int i = 0; i < 2; i++) {
+        rgb_panel_stats_t *st = &self->stats[i];
+        st->flushes++;
+        st->renders += last;
+        st->px_flushed += px;
+        st->bytes_copied += copied;
+        st->flush_us += us;
     }
+}
 
-    if (self->panel_handle != NULL) {
-        esp_lcd_panel_del(self->panel_handle);
-        self->panel_handle = NULL;
+static void rgb_panel_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_display_get_user_data(disp);
+    int64_t t0 = esp_timer_get_time();
+    rgb_panel_trace_at(RGB_PANEL_TRACE_FLUSH_BEGIN, rgb_panel_area_px(area), (uint32_t)t0);
+
+    /* First area of a new frame: restart the per-frame counters */
+    if (self->sync_count == 0) {
+        self->sync_areas_last = 0;
+        self->sync_dirty_last = 0;
     }
 
-    if (self->backlight >= 0) {
-        gpio_set_level(self->backlight, 0);
+    uint32_t dirty = rgb_panel_area_px(area) * sizeof(uint16_t);
+    self->sync_areas_last++;
+    self->sync_dirty_last += dirty;
+    self->sync_dirty_total += dirty;
+    rgb_panel_sync_add(self, area);
+
+    if (!lv_display_flush_is_last(disp)) {
+        /* Nothing to hand off yet; LVGL renders the next area elsewhere */
+        lv_display_flush_ready(disp);
+        rgb_panel_stats_flush(self, area, false, 0, t0);
+        return;
     }
 
-    self->framebuffer = NULL;
-    return mp_const_none;
+    /* Get both framebuffer pointers from the RGB panel */
+    void *fb0 = NULL, *fb1 = NULL;
+    rgb_panel_get_fbs(self, &fb0, &fb1);
+
+    /* px_map is the buffer LVGL just rendered into; the other one is stale */
+    self->front_fb = px_map;
+    rgb_panel_slot.front_fb = px_map;
+    self->sync_src = px_map;
+    self->sync_dst = (px_map == (uint8_t *)fb0) ? (uint8_t *)fb1 : (uint8_t *)fb0;
+
+    /* Queue the displayed-buffer swap.  Marked pending only afterwards: a
+     * VSYNC in between then costs one extra frame of waiting, never an early
+     * release.  Flush-ready follows once the swap is latched, from
+     * rgb_panel_flush_wait_cb() / rgb_panel_refr_start_cb(). */
+    xSemaphoreTake(self->isr->swap_done, 0);
+    self->swap_queued_us = esp_timer_get_time();
+    esp_lcd_panel_draw_bitmap(self->panel_handle, 0, 0,
+                              RGB_PANEL_WIDTH(self), RGB_PANEL_HEIGHT(self), px_map);
+    self->isr->swap_pending = 1;
+    rgb_panel_trace_at(RGB_PANEL_TRACE_SWAP_QUEUED, 0, (uint32_t)self->swap_queued_us);
+    rgb_panel_stats_flush(self, area, true, 0, t0);
 }
-static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_deinit_obj, rgb_panel_deinit);
 
-/* backlight(on) — control backlight GPIO */
-static mp_obj_t rgb_panel_backlight(mp_obj_t self_in, mp_obj_t on_in) {
-    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    if (self->backlight >= 0) {
-        gpio_set_level(self->backlight, mp_obj_is_true(on_in) ? 1 : 0);
+#if RGB_PANEL_HAS_PARTIAL
+/*
+ * PARTIAL mode: LVGL renders strips into internal SRAM and each one is
+ * copied into the single PSRAM framebuffer that is scanned out.  With async
+ * memcpy, invalidated areas are widened to full rows (see
+ * rgb_panel_invalidate_cb()), so a strip is one contiguous DMA transaction
+ * and LVGL can render the next strip into the other draw buffer meanwhile;
+ * flush_wait_cb then waits for it.  Otherwise esp_lcd copies it on the CPU.
+ */
+static void rgb_panel_flush_partial_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_display_get_user_data(disp);
+    int64_t t0 = esp_timer_get_time();
+    rgb_panel_trace_at(RGB_PANEL_TRACE_FLUSH_BEGIN, rgb_panel_area_px(area), (uint32_t)t0);
+    bool last = lv_display_flush_is_last(disp);
+    uint32_t copied = rgb_panel_area_px(area) * sizeof(uint16_t);
+
+    if (self->mcp != NULL && area->x1 == 0 && area->x2 == RGB_PANEL_WIDTH(self) - 1) {
+        size_t stride = RGB_PANEL_STRIDE(self);
+        size_t len = (size_t)lv_area_get_height(area) * stride;
+        uint8_t *dst = (uint8_t *)self->framebuffer + (size_t)area->y1 * stride;
+        if (rgb_panel_dma_rows(self, dst, px_map, len, area->y1, area->y2)) {
+            rgb_panel_stats_flush(self, area, last, copied, t0);
+            return;
+        }
     }
-    return mp_const_none;
+
+    esp_lcd_panel_draw_bitmap(self->panel_handle, area->x1, area->y1,
+                              area->x2 + 1, area->y2 + 1, px_map);
+    lv_display_flush_ready(disp);
+    rgb_panel_stats_flush(self, area, last, copied, t0);
 }
-static MP_DEFINE_CONST_FUN_OBJ_2(rgb_panel_backlight_obj, rgb_panel_backlight);
 
-/* framebuffer(index) — return memoryview of DMA framebuffer 0 or 1 */
-static mp_obj_t rgb_panel_framebuffer(mp_obj_t self_in, mp_obj_t idx_in) {
-    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    if (!self->panel_handle) {
-        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("not initialised"));
-    }
-    void *fb0 = NULL, *fb1 = NULL;
-    esp_lcd_rgb_panel_get_frame_buffer(self->panel_handle, 2, &fb0, &fb1);
+/* PARTIAL + async copy: round invalidated areas out to whole rows */
+static void rgb_panel_invalidate_cb(lv_event_t *e) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_event_get_user_data(e);
+    lv_area_t *area = (lv_area_t *)lv_event_get_param(e);
+    area->x1 = 0;
+    area->x2 = RGB_PANEL_WIDTH(self) - 1;
+}
+#endif /* RGB_PANEL_HAS_PARTIAL */
+
+/* LVGL waits here before reusing a buffer with a flush outstanding */
+static void rgb_panel_flush_wait_cb(lv_display_t *disp) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_display_get_user_data(disp);
+    rgb_panel_swap_wait(self);
+    rgb_panel_copy_wait(self);
+}
+
+/*
+ * Start of every refresh, before LVGL touches either buffer: let the swap
+ * queued by the previous frame land, release that flush and start its sync
+ * copy.  DIRECT mode would otherwise only wait before the *next flush*, after
+ * it has already rendered into the buffer still on screen.  Also where the gap between
+ * refresh timer runs is measured, in both render modes.
+ */
+static void rgb_panel_refr_start_cb(lv_event_t *e) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_event_get_user_data(e);
+    int64_t now = esp_timer_get_time();
+    uint32_t gap = self->refr_last_us ? (uint32_t)(now - self->refr_last_us) : 0;
+    self->refr_last_us = now;
+    rgb_panel_trace_at(RGB_PANEL_TRACE_REFR_START, 0, (uint32_t)now);
+    for (int i = 0; i < 2; i++) {
+        rgb_panel_stats_t *st = &self->stats[i];
+        st->refreshes++;
+        st->gap_us += gap;
+        if (gap > st->gap_max_us) st->gap_max_us = gap;
+    }
+
+    rgb_panel_swap_finish(self);
+}
+
+/*
+ * Runs right before LVGL renders into the stale buffer: it must be up to
+ * date.  The sync copy normally started at refresh start and only the DMA
+ * bands still in flight are waited for here; it runs now only if the swap
+ * was let land elsewhere (flush_wait_cb) without starting it.
+ */
+static void rgb_panel_render_start_cb(lv_event_t *e) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_event_get_user_data(e);
+    rgb_panel_swap_wait(self);
+    rgb_panel_sync_run(self);
+    if (self->copy_y1 <= self->copy_y2) {
+        int64_t t0 = esp_timer_get_time();
+        rgb_panel_copy_wait(self);
+        rgb_panel_copy_account(self, t0);
+    }
+}
+
+/* Install the async memcpy engine; falls back to CPU copies on failure */
+static void setup_async_copy(rgb_panel_obj_t *self) {
+    rgb_panel_isr_ctx_t *isr = self->isr;
+    isr->copies_pending = 0;
+    isr->copy_done = xSemaphoreCreateBinary();
+    if (isr->copy_done == NULL) {
+        ESP_LOGW(TAG, "Async copy disabled: no memory for semaphore");
+        return;
+    }
+
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog = 16;
+    config.sram_trans_align = 4;
+    config.psram_trans_align = 64;
+    esp_err_t err = esp_async_memcpy_install(&config, &self->mcp);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Async copy disabled: %s", esp_err_to_name(err));
+        vSemaphoreDelete(isr->copy_done);
+        isr->copy_done = NULL;
+        self->mcp = NULL;
+        return;
+    }
+    self->copy_y1 = INT32_MAX;
+    self->copy_y2 = -1;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  LVGL display registration                                                */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+static void setup_lvgl_display(rgb_panel_obj_t *self) {
+    lv_display_t *disp = lv_display_create(RGB_PANEL_WIDTH(self), RGB_PANEL_HEIGHT(self));
+    lv_display_set_user_data(disp, self);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_timer_set_period(lv_display_get_refr_timer(disp), self->refr_ms);
+    self->lv_disp = disp;
+
+    #if RGB_PANEL_HAS_PARTIAL
+    if (RGB_PANEL_IS_PARTIAL(self)) {
+        /* PARTIAL mode: LVGL draws N-line strips into internal SRAM, which
+         * is much faster than rendering into PSRAM. */
+        size_t buf_size = (size_t)RGB_PANEL_WIDTH(self) * self->draw_buf_lines * sizeof(uint16_t);
+        lv_display_set_flush_cb(disp, rgb_panel_flush_partial_cb);
+        lv_display_set_buffers(disp, self->draw_buf[0], self->draw_buf[1], buf_size,
+                               LV_DISPLAY_RENDER_MODE_PARTIAL);
+        self->front_fb = (uint8_t *)self->framebuffer;
+        if (self->mcp != NULL) {
+            lv_display_set_flush_wait_cb(disp, rgb_panel_flush_wait_cb);
+            lv_display_add_event_cb(disp, rgb_panel_invalidate_cb, LV_EVENT_INVALIDATE_AREA, self);
+        }
+    } else
+    #endif
+    {
+        /* DIRECT mode: LVGL draws directly into the panel framebuffer.
+         * Two framebuffers enable tear-free updates. */
+        void *fb0 = NULL, *fb1 = NULL;
+        rgb_panel_get_fbs(self, &fb0, &fb1);
+        size_t fb_size = (size_t)RGB_PANEL_WIDTH(self) * RGB_PANEL_HEIGHT(self) * sizeof(uint16_t);
+        lv_display_set_flush_cb(disp, rgb_panel_flush_cb);
+        /* LVGL renders its first frame into the buffer that is not on screen:
+         * fb0 is scanned out first after init(), either one after attach() */
+        uint8_t *front = self->front_fb != NULL ? self->front_fb : (uint8_t *)fb0;
+        void *back = front == (uint8_t *)fb0 ? fb1 : fb0;
+        lv_display_set_buffers(disp, back, front, fb_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+        self->front_fb = front;
+
+        lv_display_set_flush_wait_cb(disp, rgb_panel_flush_wait_cb);
+        lv_display_add_event_cb(disp, rgb_panel_render_start_cb, LV_EVENT_RENDER_START, self);
+    }
+    lv_display_add_event_cb(disp, rgb_panel_refr_start_cb, LV_EVENT_REFR_START, self);
+
+    lv_tick_set_cb(rgb_panel_tick_get_cb);
+
+    if (RGB_PANEL_IS_PARTIAL(self)) {
+        ESP_LOGI(TAG, "LVGL display registered: %dx%d PARTIAL mode, %dx%d-line SRAM buffers, %s copy",
+                 RGB_PANEL_WIDTH(self), RGB_PANEL_HEIGHT(self), self->draw_buf_count, self->draw_buf_lines,
+                 self->mcp != NULL ? "async" : "CPU");
+    } else {
+        ESP_LOGI(TAG, "LVGL display registered: %dx%d DIRECT mode, %s sync copy",
+                 RGB_PANEL_WIDTH(self), RGB_PANEL_HEIGHT(self), self->mcp != NULL ? "async" : "CPU");
+    }
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Auto-dim                                                                 */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * After dim_timeout_ms without wake() the backlight fades to dim_level.  At
+ * level 0 the panel then goes dark completely: LVGL stops invalidating,
+ * whatever was already invalidated is rendered and swapped in, and scan-out
+ * stops (with no DISP GPIO, esp_lcd's disp_on_off stops the LCD peripheral
+ * and its PSRAM reads).  Widgets can still be changed meanwhile; wake()
+ * restarts scan-out and redraws the whole screen.  Runs as an LVGL timer,
+ * so always with the display lock held and never during a render.
+ */
+static void rgb_panel_dim_timer_cb(lv_timer_t *timer) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)lv_timer_get_user_data(timer);
+    if (self->dim_state == RGB_PANEL_DIM_AWAKE) {
+        rgb_panel_bl_set(self, self->dim_level, self->dim_fade_ms);
+        self->dim_state = RGB_PANEL_DIM_FADING;
+        lv_timer_set_period(timer, self->dim_fade_ms > 0 ? self->dim_fade_ms : 1);
+        return;
+    }
+    lv_timer_pause(timer);
+    if (self->dim_level > 0) {
+        self->dim_state = RGB_PANEL_DIM_DIMMED;
+        return;
+    }
+    lv_display_enable_invalidation(self->lv_disp, false);
+    lv_refr_now(self->lv_disp);
+    rgb_panel_swap_finish(self);
+    esp_lcd_panel_disp_on_off(self->panel_handle, false);
+    rgb_panel_slot.blank = true;
+    self->dim_state = RGB_PANEL_DIM_BLANK;
+    self->dim_blanks++;
+}
+
+/* Back to bl_on_level and restart the timeout (display lock held) */
+static void rgb_panel_wake_now(rgb_panel_obj_t *self, uint32_t fade_ms) {
+    if (self->dim_state == RGB_PANEL_DIM_BLANK) {
+        esp_lcd_panel_disp_on_off(self->panel_handle, true);
+        rgb_panel_slot.blank = false;
+        lv_display_enable_invalidation(self->lv_disp, true);
+        lv_obj_invalidate(lv_display_get_screen_active(self->lv_disp));
+    }
+    rgb_panel_bl_set(self, self->bl_on_level, fade_ms);
+    self->dim_state = RGB_PANEL_DIM_AWAKE;
+    if (self->dim_timer != NULL) {
+        lv_timer_set_period(self->dim_timer, self->dim_timeout_ms);
+        lv_timer_reset(self->dim_timer);
+        lv_timer_resume(self->dim_timer);
+    }
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Snapshot streaming                                                       */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * Iterator returned by snapshot_chunks().  RAW chunks are memoryviews
+ * straight into the framebuffer; encoded chunks are written into one buffer
+ * owned by the iterator, so either way a screenshot needs no frame-sized
+ * allocation.  A chunk stays valid until the next one is requested.  With
+ * copy=True the frame is first copied into PSRAM outside the GC heap and
+ * chunks come from the copy, so LVGL can keep rendering while they are sent;
+ * the copy is freed at the end of the iteration (or by the finaliser).
+ *
+ * RLE packets, little-endian pixels like the framebuffer itself:
+ *   0x80 | (n - 1), px:u16        n copies of px       (n = 1..128)
+ *   n - 1, px:u16 * n             n literal pixels     (n = 1..128)
+ * Every chunk ends on a packet boundary.  DELTA encodes each pixel XORed with
+ * the one above it (the first row as is), which turns flat UI regions and
+ * vertical gradients into zero runs.
+ */
+typedef struct {
+    mp_obj_base_t base;
+    rgb_panel_obj_t *panel;
+    const uint16_t *fb;
+    uint16_t *copy;                 /* copy=True: private frame, fb points here */
+    size_t pos;                     /* next pixel */
+    size_t npx;
+    size_t chunk_size;
+    uint8_t *buf;                   /* encoded chunk, NULL for RAW */
+    uint16_t width;
+    uint8_t encoding;
+} rgb_panel_snapshot_obj_t;
+
+static inline uint16_t rgb_panel_snapshot_px(const rgb_panel_snapshot_obj_t *it, size_t i) {
+    uint16_t px = it->fb[i];
+    if (it->encoding == RGB_PANEL_SNAPSHOT_DELTA && i >= it->width) {
+        px ^= it->fb[i - it->width];
+    }
+    return px;
+}
+
+static size_t rgb_panel_snapshot_encode(rgb_panel_snapshot_obj_t *it) {
+    uint8_t *out = it->buf;
+    size_t n = 0;
+    while (it->pos < it->npx && it->chunk_size - n >= 3) {
+        size_t left = it->npx - it->pos;
+        size_t max = left < 128 ? left : 128;
+        uint16_t px = rgb_panel_snapshot_px(it, it->pos);
+
+        size_t run = 1;
+        while (run < max && rgb_panel_snapshot_px(it, it->pos + run) == px) run++;
+        if (run >= 2) {
+            out[n++] = 0x80 | (run - 1);
+            out[n++] = px & 0xFF;
+            out[n++] = px >> 8;
+            it->pos += run;
+            continue;
+        }
+
+        /* Literals up to the next pair of equal pixels or the end of space */
+        size_t room = (it->chunk_size - n - 1) / 2;
+        if (max > room) max = room;
+        size_t lit = 1;
+        uint16_t prev = px;
+        while (lit < max) {
+            uint16_t next = rgb_panel_snapshot_px(it, it->pos + lit);
+            if (next == prev) {
+                lit--;                      /* leave the pair to a run packet */
+                break;
+            }
+            prev = next;
+            lit++;
+        }
+        if (lit == 0) lit = 1;
+        out[n++] = lit - 1;
+        for (size_t k = 0; k < lit; k++) {
+            uint16_t v = rgb_panel_snapshot_px(it, it->pos + k);
+            out[n++] = v & 0xFF;
+            out[n++] = v >> 8;
+        }
+        it->pos += lit;
+    }
+    return n;
+}
+
+static mp_obj_t rgb_panel_snapshot___del__(mp_obj_t self_in) {
+    rgb_panel_snapshot_obj_t *it = MP_OBJ_TO_PTR(self_in);
+    if (it->copy != NULL) {
+        heap_caps_free(it->copy);
+        it->copy = NULL;
+        it->fb = NULL;
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_snapshot___del___obj, rgb_panel_snapshot___del__);
+
+static mp_obj_t rgb_panel_snapshot_iternext(mp_obj_t self_in) {
+    rgb_panel_snapshot_obj_t *it = MP_OBJ_TO_PTR(self_in);
+    if (it->pos >= it->npx) {
+        rgb_panel_snapshot___del__(self_in);    /* the last chunk has been used */
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (it->copy == NULL && it->panel->panel_handle == NULL) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("panel deinitialised during snapshot"));
+    }
+
+    if (it->encoding == RGB_PANEL_SNAPSHOT_RAW) {
+        size_t px = it->chunk_size / sizeof(uint16_t);
+        if (px > it->npx - it->pos) px = it->npx - it->pos;
+        const uint16_t *start = it->fb + it->pos;
+        it->pos += px;
+        return mp_obj_new_memoryview('B', px * sizeof(uint16_t), (void *)start);
+    }
+
+    size_t n = rgb_panel_snapshot_encode(it);
+    return mp_obj_new_memoryview('B', n, it->buf);
+}
+
+static const mp_rom_map_elem_t rgb_panel_snapshot_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&rgb_panel_snapshot___del___obj) },
+};
+static MP_DEFINE_CONST_DICT(rgb_panel_snapshot_locals_dict, rgb_panel_snapshot_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    rgb_panel_snapshot_type,
+    MP_QSTR_snapshot_chunks,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    iter, rgb_panel_snapshot_iternext,
+    locals_dict, &rgb_panel_snapshot_locals_dict
+);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Native LVGL refresh task                                                 */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * lv_timer_handler() can call back into Python (event handlers, lv.timer),
+ * so the task is a registered MicroPython thread and renders with the GIL
+ * held: LVGL allocates from the GC heap too, and with a GIL the GC has no
+ * lock of its own.  The GIL is only dropped while the task blocks (display
+ * lock, VSYNC and DMA waits, the sleep between runs).  So frames no longer
+ * wait for the main loop to call lv.task_handler(), but a GC pass or a
+ * native call that keeps the GIL still delays them, and Python threads stall
+ * while a frame renders.
+ * Python code touching widgets takes lvgl_lock via lock() / `with`.
+ * Lock order is always lvgl_lock, then the GIL: lock() drops the GIL while
+ * it waits, so the two threads can never hold one each and block.
+ * Firmware only: the host build has no FreeRTOS to run it on.
+ */
+#define RGB_PANEL_HAS_LVGL_TASK (MICROPY_PY_THREAD && !RGB_PANEL_SIM)
+
+#if RGB_PANEL_HAS_LVGL_TASK
+static void *rgb_panel_lvgl_task(void *arg) {
+    rgb_panel_obj_t *self = (rgb_panel_obj_t *)arg;
+
+    mp_state_thread_t ts;
+    mp_thread_init_state(&ts, RGB_PANEL_LVGL_TASK_STACK - 1024, NULL, self->task_globals);
+    mp_thread_start();
+
+    while (self->task_run) {
+        MP_THREAD_GIL_EXIT();
+        xSemaphoreTakeRecursive(self->lvgl_lock, portMAX_DELAY);
+        MP_THREAD_GIL_ENTER();
+
+        uint32_t sleep_ms = RGB_PANEL_LVGL_TASK_MAX_SLEEP_MS;
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            rgb_panel_trace(RGB_PANEL_TRACE_TIMER_BEGIN, 0);
+            sleep_ms = lv_timer_handler();
+            rgb_panel_trace(RGB_PANEL_TRACE_TIMER_END, sleep_ms);
+            nlr_pop();
+        } else {
+            /* An exception in a Python LVGL callback must not kill rendering */
+            mp_obj_print_exception(&mp_plat_print, MP_OBJ_FROM_PTR(nlr.ret_val));
+        }
+
+        MP_THREAD_GIL_EXIT();
+        xSemaphoreGiveRecursive(self->lvgl_lock);
+        /* Sleep until the next LVGL timer is due.  The refresh timer pauses
+         * itself once nothing is invalidated (LV_USE_PERF_MONITOR off), so an
+         * idle UI sleeps for the cap; unlock() wakes it early when Python has
+         * changed something. */
+        if (sleep_ms < 1) sleep_ms = 1;
+        if (sleep_ms > RGB_PANEL_LVGL_TASK_MAX_SLEEP_MS) sleep_ms = RGB_PANEL_LVGL_TASK_MAX_SLEEP_MS;
+        xSemaphoreTake(self->task_wake, pdMS_TO_TICKS(sleep_ms) ? pdMS_TO_TICKS(sleep_ms) : 1);
+        MP_THREAD_GIL_ENTER();
+    }
+
+    mp_thread_finish();
+    xSemaphoreGive(self->task_exit);
+    MP_THREAD_GIL_EXIT();
+    return NULL;
+}
+
+/* ports/esp32/mpthreadport.c: like mp_thread_create() with priority + name */
+extern mp_uint_t mp_thread_create_ex(void *(*entry)(void *), void *arg, size_t *stack_size,
+                                     int priority, char *name);
+#endif
+
+static void start_lvgl_task(rgb_panel_obj_t *self) {
+    #if RGB_PANEL_HAS_LVGL_TASK
+    self->lvgl_lock = xSemaphoreCreateRecursiveMutex();
+    self->task_exit = xSemaphoreCreateBinary();
+    self->task_wake = xSemaphoreCreateBinary();
+    if (self->lvgl_lock == NULL || self->task_exit == NULL || self->task_wake == NULL) {
+        mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no memory for LVGL task"));
+    }
+    self->task_globals = mp_globals_get();
+    self->task_run = true;
+
+    size_t stack_size = RGB_PANEL_LVGL_TASK_STACK;
+    mp_thread_create_ex(rgb_panel_lvgl_task, self, &stack_size,
+                        RGB_PANEL_LVGL_TASK_PRIO, "lvgl");
+    ESP_LOGI(TAG, "LVGL refresh task started (core %d, prio %d)",
+             MP_TASK_COREID, RGB_PANEL_LVGL_TASK_PRIO);
+    #elif RGB_PANEL_SIM
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("lvgl_task not available on the host build"));
+    #else
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("lvgl_task needs MICROPY_PY_THREAD"));
+    #endif
+}
+
+static bool stop_lvgl_task(rgb_panel_obj_t *self) {
+    if (self->task_run) {
+        self->task_run = false;
+        xSemaphoreGive(self->task_wake);
+        MP_THREAD_GIL_EXIT();
+        BaseType_t stopped = xSemaphoreTake(self->task_exit, pdMS_TO_TICKS(1000));
+        MP_THREAD_GIL_ENTER();
+        if (stopped != pdTRUE) {
+            /* Still inside lv_timer_handler (or blocked on a lock we hold):
+             * keep its semaphores alive rather than free them under it */
+            ESP_LOGW(TAG, "LVGL task did not stop");
+            return false;
+        }
+    }
+    if (self->lvgl_lock != NULL) {
+        vSemaphoreDelete(self->lvgl_lock);
+        self->lvgl_lock = NULL;
+    }
+    if (self->task_exit != NULL) {
+        vSemaphoreDelete(self->task_exit);
+        self->task_exit = NULL;
+    }
+    if (self->task_wake != NULL) {
+        vSemaphoreDelete(self->task_wake);
+        self->task_wake = NULL;
+    }
+    return true;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  MicroPython constructor                                                  */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+static mp_obj_t rgb_panel_make_new(const mp_obj_type_t *type, size_t n_args,
+                                    size_t n_kw, const mp_obj_t *all_args) {
+    enum {
+        ARG_width, ARG_height,
+        ARG_data_pins,
+        ARG_hsync_pin, ARG_vsync_pin, ARG_de_pin, ARG_pclk_pin,
+        ARG_pclk_freq,
+        ARG_hsync_pulse_width, ARG_hsync_back_porch, ARG_hsync_front_porch,
+        ARG_vsync_pulse_width, ARG_vsync_back_porch, ARG_vsync_front_porch,
+        ARG_spi_scl, ARG_spi_sda, ARG_spi_cs,
+        ARG_backlight, ARG_backlight_freq, ARG_backlight_level,
+        ARG_init_cmds,
+        ARG_bounce_buffer_lines, ARG_bounce_buffer_core,
+        ARG_async_copy,
+        ARG_render_mode, ARG_draw_buf_lines, ARG_draw_buf_count,
+        ARG_lvgl_task,
+        ARG_spi_backend, ARG_spi_freq,
+        ARG_boot_log,
+        ARG_pool_size, ARG_sram_pool_size,
+    };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width,               MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_height,              MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_data_pins,           MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_hsync_pin,           MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_vsync_pin,           MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_de_pin,              MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_pclk_pin,            MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_pclk_freq,           MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 12000000} },
+        { MP_QSTR_hsync_pulse_width,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 8} },
+        { MP_QSTR_hsync_back_porch,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 20} },
+        { MP_QSTR_hsync_front_porch,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
+        { MP_QSTR_vsync_pulse_width,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 8} },
+        { MP_QSTR_vsync_back_porch,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
+        { MP_QSTR_vsync_front_porch,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
+        { MP_QSTR_spi_scl,             MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_spi_sda,             MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_spi_cs,              MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_backlight,           MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_backlight_freq,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_backlight_level,     MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 100} },
+        { MP_QSTR_init_cmds,           MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_bounce_buffer_lines, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_bounce_buffer_core,  MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_async_copy,          MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_render_mode,         MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = RGB_PANEL_RENDER_DIRECT} },
+        { MP_QSTR_draw_buf_lines,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 40} },
+        { MP_QSTR_draw_buf_count,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 2} },
+        { MP_QSTR_lvgl_task,           MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_spi_backend,         MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = RGB_PANEL_SPI_BITBANG} },
+        { MP_QSTR_spi_freq,            MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4000000} },
+        { MP_QSTR_boot_log,            MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_pool_size,           MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_sram_pool_size,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args,
+                              MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    rgb_panel_obj_t *self = mp_obj_malloc(rgb_panel_obj_t, &rgb_panel_type);
+
+    self->width = args[ARG_width].u_int;
+    self->height = args[ARG_height].u_int;
+    if (RGB_PANEL_WIDTH(self) != args[ARG_width].u_int || RGB_PANEL_HEIGHT(self) != args[ARG_height].u_int) {
+        mp_raise_ValueError(MP_ERROR_TEXT("resolution differs from the one built in"));
+    }
+
+    /* Parse data_pins list (must be exactly 16 GPIOs) */
+    mp_obj_t *pin_items;
+    size_t pin_count;
+    mp_obj_get_array(args[ARG_data_pins].u_obj, &pin_count, &pin_items);
+    if (pin_count != 16) {
+        mp_raise_ValueError(MP_ERROR_TEXT("data_pins must have exactly 16 elements"));
+    }
+    for (int i = 0; i < 16; i++) {
+        self->data[i] = mp_obj_get_int(pin_items[i]);
+    }
+
+    self->hsync = args[ARG_hsync_pin].u_int;
+    self->vsync = args[ARG_vsync_pin].u_int;
+    self->de = args[ARG_de_pin].u_int;
+    self->pclk = args[ARG_pclk_pin].u_int;
+
+    self->pclk_freq = args[ARG_pclk_freq].u_int;
+    self->hsync_pulse_width = args[ARG_hsync_pulse_width].u_int;
+    self->hsync_back_porch = args[ARG_hsync_back_porch].u_int;
+    self->hsync_front_porch = args[ARG_hsync_front_porch].u_int;
+    self->vsync_pulse_width = args[ARG_vsync_pulse_width].u_int;
+    self->vsync_back_porch = args[ARG_vsync_back_porch].u_int;
+    self->vsync_front_porch = args[ARG_vsync_front_porch].u_int;
+
+    self->spi_cs = args[ARG_spi_cs].u_int;
+    self->spi_clk = args[ARG_spi_scl].u_int;
+    self->spi_mosi = args[ARG_spi_sda].u_int;
+    mp_int_t spi_backend = args[ARG_spi_backend].u_int;
+    if (spi_backend != RGB_PANEL_SPI_BITBANG && spi_backend != RGB_PANEL_SPI_HW) {
+        mp_raise_ValueError(MP_ERROR_TEXT("spi_backend must be SPI_BITBANG or SPI_HW"));
+    }
+    self->spi_backend = spi_backend;
+    self->spi_freq = args[ARG_spi_freq].u_int;
+    self->spi_dev = NULL;
+    if (!MICROPY_HW_RGB_PANEL_SPI_INIT && self->spi_clk >= 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("SPI panel init not built in"));
+    }
+    self->boot_log = args[ARG_boot_log].u_bool;
+    self->boot_start_us = 0;
+    self->boot_mark_us = 0;
+    memset(self->boot_us, 0, sizeof(self->boot_us));
+
+    self->backlight = args[ARG_backlight].u_int;
+    mp_int_t bl_freq = args[ARG_backlight_freq].u_int;
+    mp_int_t bl_level = args[ARG_backlight_level].u_int;
+    if (bl_freq < 0 || bl_freq > 40000) {
+        mp_raise_ValueError(MP_ERROR_TEXT("backlight_freq must be 0..40000 Hz"));
+    }
+    if (bl_level < 0 || bl_level > 100) {
+        mp_raise_ValueError(MP_ERROR_TEXT("backlight level must be 0..100"));
+    }
+    self->bl_freq = (uint32_t)bl_freq;
+    self->bl_on_level = (uint8_t)bl_level;
+    self->bl_level = 0;
+    self->dim_timer = NULL;
+    self->dim_timeout_ms = 0;
+    self->dim_fade_ms = 0;
+    self->dim_level = 0;
+    self->dim_state = RGB_PANEL_DIM_AWAKE;
+    self->dim_blanks = 0;
+    self->init_cmds = args[ARG_init_cmds].u_obj;
+
+    /* esp_lcd needs the framebuffer to be an even number of bounce buffers */
+    mp_int_t bb_lines = args[ARG_bounce_buffer_lines].u_int;
+    if (bb_lines < 0 || (bb_lines > 0 && RGB_PANEL_HEIGHT(self) % (2 * bb_lines) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("height must be a multiple of 2*bounce_buffer_lines"));
+    }
+    mp_int_t bb_core = args[ARG_bounce_buffer_core].u_int;
+    if (bb_core < -1 || bb_core > 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bounce_buffer_core must be -1, 0 or 1"));
+    }
+    if (!MICROPY_HW_RGB_PANEL_BOUNCE && bb_lines > 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bounce buffers not built in"));
+    }
+    self->bb_lines = bb_lines;
+    self->bb_core = bb_core;
+    self->async_copy = args[ARG_async_copy].u_bool;
+
+    mp_int_t render_mode = args[ARG_render_mode].u_int;
+    if (render_mode != RGB_PANEL_RENDER_DIRECT && render_mode != RGB_PANEL_RENDER_PARTIAL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("render_mode must be RENDER_DIRECT or RENDER_PARTIAL"));
+    }
+    #ifdef MICROPY_HW_RGB_PANEL_RENDER_MODE
+    if (render_mode != MICROPY_HW_RGB_PANEL_RENDER_MODE) {
+        mp_raise_ValueError(MP_ERROR_TEXT("render_mode differs from the one built in"));
+    }
+    #endif
+    mp_int_t draw_buf_lines = args[ARG_draw_buf_lines].u_int;
+    if (draw_buf_lines < 1 || draw_buf_lines > RGB_PANEL_HEIGHT(self)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("draw_buf_lines must be 1..height"));
+    }
+    mp_int_t draw_buf_count = args[ARG_draw_buf_count].u_int;
+    if (draw_buf_count < 1 || draw_buf_count > 2) {
+        mp_raise_ValueError(MP_ERROR_TEXT("draw_buf_count must be 1 or 2"));
+    }
+    self->render_mode = render_mode;
+    self->num_fbs = RGB_PANEL_IS_PARTIAL(self) ? 1 : 2;
+    self->draw_buf_lines = draw_buf_lines;
+    self->draw_buf_count = draw_buf_count;
+    self->draw_buf[0] = NULL;
+    self->draw_buf[1] = NULL;
+    self->lvgl_task = args[ARG_lvgl_task].u_bool;
+    mp_int_t pool_size = args[ARG_pool_size].u_int;
+    mp_int_t sram_pool_size = args[ARG_sram_pool_size].u_int;
+    if (pool_size < 0 || sram_pool_size < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("pool sizes must be >= 0"));
+    }
+    self->pool_size = pool_size;
+    self->sram_pool_size = sram_pool_size;
+    self->task_run = false;
+    self->lvgl_lock = NULL;
+    self->task_exit = NULL;
+    self->task_wake = NULL;
+    self->task_globals = NULL;
+    self->refr_ms = LV_DEF_REFR_PERIOD;
+
+    self->panel_handle = NULL;
+    self->framebuffer = NULL;
+    self->lv_disp = NULL;
+    self->isr = NULL;
+    self->mcp = NULL;
+    self->sync_count = 0;
+    self->sync_src = NULL;
+    self->sync_dst = NULL;
+    self->sync_frames = 0;
+    self->sync_areas_last = 0;
+    self->sync_rects_last = 0;
+    self->sync_bytes_last = 0;
+    self->sync_dirty_last = 0;
+    self->sync_bytes_total = 0;
+    self->sync_dirty_total = 0;
+    memset(self->stats, 0, sizeof(self->stats));
+    self->refr_last_us = 0;
+    self->swap_queued_us = 0;
+    self->front_fb = NULL;
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Warm restart                                                             */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+static uint32_t rgb_panel_fnv1a(uint32_t h, uint32_t v) {
+    for (int i = 0; i < 4; i++, v >>= 8) {
+        h = (h ^ (v & 0xFF)) * 16777619u;
+    }
+    return h;
+}
+
+/* Everything the panel, its buffers and the backlight were set up from.
+ * The SPI pins and init_cmds only matter for the init sequence. */
+static uint32_t rgb_panel_slot_key(const rgb_panel_obj_t *self) {
+    const uint32_t v[] = {
+        RGB_PANEL_WIDTH(self), RGB_PANEL_HEIGHT(self), self->pclk_freq,
+        self->hsync_pulse_width, self->hsync_back_porch, self->hsync_front_porch,
+        self->vsync_pulse_width, self->vsync_back_porch, self->vsync_front_porch,
+        self->pclk, self->hsync, self->vsync, self->de,
+        RGB_PANEL_BB_LINES(self), self->bb_core, RGB_PANEL_IS_PARTIAL(self), self->num_fbs,
+        self->draw_buf_count, self->draw_buf_lines, self->async_copy,
+        self->backlight, self->bl_freq,
+    };
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(v); i++) {
+        h = rgb_panel_fnv1a(h, v[i]);
+    }
+    for (int i = 0; i < 16; i++) {
+        h = rgb_panel_fnv1a(h, self->data[i]);
+    }
+    return h;
+}
+
+/* Free a panel left behind by a soft reset that init() is about to replace */
+static void rgb_panel_slot_release(void) {
+    rgb_panel_slot_t *slot = &rgb_panel_slot;
+    if (slot->panel == NULL) return;
+    esp_lcd_panel_del(slot->panel);
+    if (slot->mcp != NULL) {
+        while (__atomic_load_n(&slot->isr->copies_pending, __ATOMIC_SEQ_CST) != 0) {
+            xSemaphoreTake(slot->isr->copy_done, pdMS_TO_TICKS(100));
+        }
+        esp_async_memcpy_uninstall(slot->mcp);
+        vSemaphoreDelete(slot->isr->copy_done);
+    }
+    for (int i = 0; i < 2; i++) {
+        heap_caps_free(slot->draw_buf[i]);
+    }
+    vSemaphoreDelete(slot->isr->swap_done);
+    heap_caps_free(slot->isr);
+    memset(slot, 0, sizeof(*slot));
+}
+
+/* Steps 4-5 of init(), shared with attach(): register with LVGL */
+static void rgb_panel_start_lvgl(rgb_panel_obj_t *self) {
+    rgb_panel_stats_reset(self, RGB_PANEL_STATS_TOTAL);
+    rgb_panel_stats_reset(self, RGB_PANEL_STATS_WINDOW);
+    self->refr_last_us = 0;
+    self->swap_queued_us = 0;
+    rgb_panel_pools_install(self);
+    rgb_panel_cache_probes_install();
+    setup_lvgl_display(self);
+    rgb_panel_boot_mark(self, RGB_PANEL_BOOT_LVGL);
+
+    /* Optionally hand lv_timer_handler() to a native task */
+    if (self->lvgl_task) {
+        start_lvgl_task(self);
+    }
+    rgb_panel_boot_mark(self, RGB_PANEL_BOOT_LVGL_TASK);
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Methods                                                                  */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/* init() — set up hardware, send init sequence, register LVGL display */
+static mp_obj_t rgb_panel_init(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    memset(self->boot_us, 0, sizeof(self->boot_us));
+    self->boot_start_us = esp_timer_get_time();
+    self->boot_mark_us = self->boot_start_us;
+
+    uint32_t key = rgb_panel_slot_key(self);
+    if (self->panel_handle == NULL) {
+        rgb_panel_slot_release();
+    }
+    self->front_fb = NULL;
+
+    if (self->isr == NULL) {
+        self->isr = heap_caps_calloc(1, sizeof(rgb_panel_isr_ctx_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (self->isr == NULL) {
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no internal RAM for ISR state"));
+        }
+        self->isr->swap_done = xSemaphoreCreateBinary();
+        if (self->isr->swap_done == NULL) {
+            heap_caps_free(self->isr);
+            self->isr = NULL;
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no internal RAM for ISR state"));
+        }
+    }
+
+    /* PARTIAL mode draw buffers: internal, DMA-capable, cache-line aligned */
+    if (RGB_PANEL_IS_PARTIAL(self) && self->draw_buf[0] == NULL) {
+        size_t buf_size = (size_t)RGB_PANEL_WIDTH(self) * self->draw_buf_lines * sizeof(uint16_t);
+        for (int i = 0; i < self->draw_buf_count; i++) {
+            self->draw_buf[i] = heap_caps_aligned_alloc(64, buf_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+            if (self->draw_buf[i] == NULL) {
+                heap_caps_free(self->draw_buf[0]);
+                self->draw_buf[0] = NULL;
+                mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no internal RAM for draw buffers"));
+            }
+        }
+    }
+    rgb_panel_boot_mark(self, RGB_PANEL_BOOT_ALLOC);
+
+    /* 1. SPI init (only if SPI pins are configured) */
+    #if MICROPY_HW_RGB_PANEL_SPI_INIT
+    if (self->spi_clk >= 0) {
+        if (self->spi_backend != RGB_PANEL_SPI_HW || !spi_hw_open(self)) {
+            setup_spi_pins(self);
+        }
+        rgb_panel_boot_mark(self, RGB_PANEL_BOOT_SPI_SETUP);
+        run_init_cmds(self);
+        spi_hw_close(self);
+        rgb_panel_boot_mark(self, RGB_PANEL_BOOT_INIT_CMDS);
+    }
+    #endif
+
+    /* 2. Set up the RGB panel with ESP-IDF lcd driver (marks its own stages) */
+    setup_rgb_panel(self);
+
+    /* 3. Turn on backlight */
+    if (self->backlight >= 0) {
+        setup_backlight(self);
+        rgb_panel_bl_set(self, self->bl_on_level, 0);
+    }
+    rgb_panel_boot_mark(self, RGB_PANEL_BOOT_BACKLIGHT);
+
+    /* 4. Register LVGL display driver, 5. optionally start the LVGL task */
+    if (self->async_copy) {
+        setup_async_copy(self);
+    }
+    rgb_panel_start_lvgl(self);
+
+    rgb_panel_slot = (rgb_panel_slot_t){
+        .panel = self->panel_handle,
+        .isr = self->isr,
+        .mcp = self->mcp,
+        .draw_buf = { self->draw_buf[0], self->draw_buf[1] },
+        .front_fb = self->front_fb,
+        .bl_freq = self->bl_freq,
+        .key = key,
+    };
+
+    if (self->boot_log) {
+        const uint32_t *t = self->boot_us;
+        ESP_LOGI(TAG, "boot us: alloc=%u spi=%u cmds=%u create=%u panel=%u bl=%u lvgl=%u task=%u total=%u",
+                 (unsigned)t[RGB_PANEL_BOOT_ALLOC], (unsigned)t[RGB_PANEL_BOOT_SPI_SETUP],
+                 (unsigned)t[RGB_PANEL_BOOT_INIT_CMDS], (unsigned)t[RGB_PANEL_BOOT_PANEL_CREATE],
+                 (unsigned)t[RGB_PANEL_BOOT_PANEL_INIT], (unsigned)t[RGB_PANEL_BOOT_BACKLIGHT],
+                 (unsigned)t[RGB_PANEL_BOOT_LVGL], (unsigned)t[RGB_PANEL_BOOT_LVGL_TASK],
+                 (unsigned)(self->boot_mark_us - self->boot_start_us));
+    }
+
+    ESP_LOGI(TAG, "RGB panel init complete");
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_init_obj, rgb_panel_init);
+
+/* deinit() — tear down display */
+static mp_obj_t rgb_panel_deinit(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if (!stop_lvgl_task(self)) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("LVGL task did not stop (lock held?)"));
+    }
+
+    if (self->dim_timer != NULL) {
+        lv_timer_delete(self->dim_timer);
+        self->dim_timer = NULL;
+    }
+    self->dim_state = RGB_PANEL_DIM_AWAKE;
+
+    if (self->lv_disp != NULL) {
+        lv_display_delete(self->lv_disp);
+        self->lv_disp = NULL;
+    }
+
+    if (self->mcp != NULL) {
+        rgb_panel_copy_wait(self);
+        esp_async_memcpy_uninstall(self->mcp);
+        self->mcp = NULL;
+        vSemaphoreDelete(self->isr->copy_done);
+        self->isr->copy_done = NULL;
+    }
+
+    if (self->panel_handle != NULL) {
+        if (rgb_panel_slot.panel == self->panel_handle) {
+            memset(&rgb_panel_slot, 0, sizeof(rgb_panel_slot));
+        }
+        esp_lcd_panel_del(self->panel_handle);
+        self->panel_handle = NULL;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (self->draw_buf[i] != NULL) {
+            heap_caps_free(self->draw_buf[i]);
+            self->draw_buf[i] = NULL;
+        }
+    }
+
+    if (self->isr != NULL) {
+        vSemaphoreDelete(self->isr->swap_done);
+        heap_caps_free(self->isr);
+        self->isr = NULL;
+    }
+
+    if (self->backlight >= 0 && self->bl_freq > 0) {
+        ledc_stop(RGB_PANEL_BL_LEDC_MODE, RGB_PANEL_BL_LEDC_CHANNEL, 0);
+    } else if (self->backlight >= 0) {
+        gpio_set_level(self->backlight, 0);
+    }
+    self->bl_level = 0;
+
+    self->framebuffer = NULL;
+    self->front_fb = NULL;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_deinit_obj, rgb_panel_deinit);
+
+/*
+ * attach() — take over the panel an init() before the last soft reset left
+ * running, if it was set up with the same arguments, instead of init().  The
+ * screen keeps showing the old frame until LVGL draws the new one: no init
+ * sequence, panel reset or backlight flash.  Returns False (nothing done)
+ * when there is no such panel; init() then releases it.
+ */
+static mp_obj_t rgb_panel_attach(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    rgb_panel_slot_t *slot = &rgb_panel_slot;
+    if (self->panel_handle != NULL) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("already initialised"));
+    }
+    if (slot->panel == NULL || slot->key != rgb_panel_slot_key(self)) {
+        return mp_const_false;
+    }
+
+    memset(self->boot_us, 0, sizeof(self->boot_us));
+    self->boot_start_us = esp_timer_get_time();
+    self->boot_mark_us = self->boot_start_us;
+
+    self->panel_handle = slot->panel;
+    self->isr = slot->isr;
+    self->mcp = slot->mcp;
+    self->draw_buf[0] = slot->draw_buf[0];
+    self->draw_buf[1] = slot->draw_buf[1];
+    void *fb0 = NULL, *fb1 = NULL;
+    rgb_panel_get_fbs(self, &fb0, &fb1);
+    self->framebuffer = (uint16_t *)fb0;
+    self->front_fb = RGB_PANEL_IS_PARTIAL(self) ? (uint8_t *)fb0 : slot->front_fb;
+
+    /* Copies and the swap the old instance queued land first; which rows
+     * its copies wrote is lost, so every cached line is dropped */
+    if (self->mcp != NULL) {
+        self->copy_y1 = 0;
+        self->copy_y2 = RGB_PANEL_HEIGHT(self) - 1;
+        rgb_panel_copy_wait(self);
+    }
+    if (slot->blank) {
+        esp_lcd_panel_disp_on_off(self->panel_handle, true);
+        slot->blank = false;
+    }
+    if (self->isr->swap_pending) {
+        rgb_panel_swap_wait(self);
+    }
+    self->isr->frames = 0;
+    self->isr->swaps = 0;
+    self->isr->first_swap_us = 0;
+
+    /* LEDC is still configured: only the level may differ */
+    self->bl_freq = slot->bl_freq;
+    rgb_panel_bl_set(self, self->bl_on_level, 0);
+    rgb_panel_boot_mark(self, RGB_PANEL_BOOT_BACKLIGHT);
+
+    rgb_panel_start_lvgl(self);
+    ESP_LOGI(TAG, "RGB panel attached in %u us", (unsigned)(self->boot_mark_us - self->boot_start_us));
+    return mp_const_true;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_attach_obj, rgb_panel_attach);
+
+static uint32_t rgb_panel_ms_arg(mp_obj_t ms_in) {
+    mp_int_t ms = mp_obj_get_int(ms_in);
+    if (ms < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ms must be >= 0"));
+    }
+    return (uint32_t)ms;
+}
+
+/*
+ * backlight(level=None, fade_ms=0) — brightness in % (True / False for
+ * 100 / 0), faded in hardware over fade_ms with backlight_freq; without it
+ * any level above 0 is just on.  It is also the level wake() returns to, and
+ * a dark auto-dimmed panel wakes up.  Before init() it only sets the level
+ * init() uses.  Returns the level in effect (a running fade's target).
+ */
+static mp_obj_t rgb_panel_backlight(size_t n_args, const mp_obj_t *args) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    if (n_args > 1) {
+        mp_int_t level = args[1] == mp_const_true ? 100 : mp_obj_get_int(args[1]);
+        if (level < 0 || level > 100) {
+            mp_raise_ValueError(MP_ERROR_TEXT("backlight level must be 0..100"));
+        }
+        uint32_t fade_ms = n_args > 2 ? rgb_panel_ms_arg(args[2]) : 0;
+        self->bl_on_level = (uint8_t)level;
+        if (self->lv_disp != NULL) {
+            rgb_panel_lock(args[0]);
+            rgb_panel_wake_now(self, fade_ms);
+            rgb_panel_unlock(args[0]);
+        }
+    }
+    return MP_OBJ_NEW_SMALL_INT(self->bl_level);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rgb_panel_backlight_obj, 1, 3, rgb_panel_backlight);
+
+/*
+ * auto_dim(timeout_ms, level=0, fade_ms=1000) — fade the backlight to level
+ * after timeout_ms without wake(); at 0 the panel also stops scan-out and
+ * rendering until the next wake() (see rgb_panel_dim_timer_cb()).
+ * timeout_ms=0 turns it off and restores the backlight.
+ */
+static mp_obj_t rgb_panel_auto_dim(size_t n_args, const mp_obj_t *args) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    if (self->lv_disp == NULL) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("not initialised"));
+    }
+    uint32_t timeout_ms = rgb_panel_ms_arg(args[1]);
+    mp_int_t level = n_args > 2 ? mp_obj_get_int(args[2]) : 0;
+    if (level < 0 || level > 100) {
+        mp_raise_ValueError(MP_ERROR_TEXT("backlight level must be 0..100"));
+    }
+    uint32_t fade_ms = n_args > 3 ? rgb_panel_ms_arg(args[3]) : 1000;
+
+    rgb_panel_lock(args[0]);
+    self->dim_timeout_ms = timeout_ms;
+    self->dim_level = (uint8_t)level;
+    self->dim_fade_ms = fade_ms;
+    if (timeout_ms == 0 && self->dim_timer != NULL) {
+        lv_timer_delete(self->dim_timer);
+        self->dim_timer = NULL;
+    } else if (timeout_ms > 0 && self->dim_timer == NULL) {
+        self->dim_timer = lv_timer_create(rgb_panel_dim_timer_cb, timeout_ms, self);
+    }
+    rgb_panel_wake_now(self, 0);
+    rgb_panel_unlock(args[0]);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rgb_panel_auto_dim_obj, 2, 4, rgb_panel_auto_dim);
+
+/*
+ * wake(fade_ms=None) — user activity: back to the backlight() level (fading
+ * over auto_dim()'s fade_ms by default) and restart the auto-dim timeout.
+ */
+static mp_obj_t rgb_panel_wake(size_t n_args, const mp_obj_t *args) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    uint32_t fade_ms = self->dim_fade_ms;
+    if (n_args > 1 && args[1] != mp_const_none) {
+        fade_ms = rgb_panel_ms_arg(args[1]);
+    }
+    if (self->lv_disp != NULL) {
+        rgb_panel_lock(args[0]);
+        /* Awake already: only push the timeout back */
+        rgb_panel_wake_now(self, self->dim_state == RGB_PANEL_DIM_AWAKE ? 0 : fade_ms);
+        rgb_panel_unlock(args[0]);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rgb_panel_wake_obj, 1, 2, rgb_panel_wake);
+
+/* backlight_info() — brightness, PWM, auto-dim state and scan-out stops */
+static mp_obj_t rgb_panel_backlight_info(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t dict = mp_obj_new_dict(7);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_level), MP_OBJ_NEW_SMALL_INT(self->bl_level));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_on_level), MP_OBJ_NEW_SMALL_INT(self->bl_on_level));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_pwm), mp_obj_new_bool(self->backlight >= 0 && self->bl_freq > 0));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_auto_dim_ms), mp_obj_new_int_from_uint(self->dim_timer != NULL ? self->dim_timeout_ms : 0));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_dimmed), mp_obj_new_bool(self->dim_state != RGB_PANEL_DIM_AWAKE));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_blanked), mp_obj_new_bool(self->dim_state == RGB_PANEL_DIM_BLANK));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_blanks), mp_obj_new_int_from_uint(self->dim_blanks));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_backlight_info_obj, rgb_panel_backlight_info);
+
+/* framebuffer(index) — return memoryview of DMA framebuffer 0 or 1 */
+static mp_obj_t rgb_panel_framebuffer(mp_obj_t self_in, mp_obj_t idx_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->panel_handle) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("not initialised"));
+    }
+    void *fb0 = NULL, *fb1 = NULL;
+    rgb_panel_get_fbs(self, &fb0, &fb1);
     int idx = mp_obj_get_int(idx_in);
     void *fb = (idx == 0) ? fb0 : fb1;
     if (!fb) return mp_const_none;
-    size_t size = (size_t)self->width * self->height * sizeof(uint16_t);
+    size_t size = (size_t)RGB_PANEL_WIDTH(self) * RGB_PANEL_HEIGHT(self) * sizeof(uint16_t);
     return mp_obj_new_memoryview('B', size, fb);
 }
-static MP_DEFINE_CONST_FUN_OBJ_2(rgb_panel_framebuffer_obj, rgb_panel_framebuffer);
+static MP_DEFINE_CONST_FUN_OBJ_2(rgb_panel_framebuffer_obj, rgb_panel_framebuffer);
+
+/*
+ * snapshot_chunks(chunk_size=4096, encoding=SNAPSHOT_RAW, copy=False) —
+ * iterate over the newest complete frame in chunks of at most chunk_size
+ * bytes.  Hold the display lock while iterating if LVGL may render
+ * meanwhile, or pass copy=True: the frame is copied (under the lock) before
+ * this returns and the iteration needs no lock.
+ */
+static mp_obj_t rgb_panel_snapshot_chunks(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_chunk_size, ARG_encoding, ARG_copy };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_chunk_size, MP_ARG_INT, {.u_int = 4096} },
+        { MP_QSTR_encoding,   MP_ARG_INT, {.u_int = RGB_PANEL_SNAPSHOT_RAW} },
+        { MP_QSTR_copy,       MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+
+    if (!self->panel_handle || self->front_fb == NULL) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("not initialised"));
+    }
+    mp_int_t chunk_size = args[ARG_chunk_size].u_int;
+    if (chunk_size < 64) {
+        mp_raise_ValueError(MP_ERROR_TEXT("chunk_size must be at least 64"));
+    }
+    mp_int_t encoding = args[ARG_encoding].u_int;
+    if (encoding != RGB_PANEL_SNAPSHOT_RAW && encoding != RGB_PANEL_SNAPSHOT_RLE &&
+        encoding != RGB_PANEL_SNAPSHOT_DELTA) {
+        mp_raise_ValueError(MP_ERROR_TEXT("encoding must be SNAPSHOT_RAW, SNAPSHOT_RLE or SNAPSHOT_DELTA"));
+    }
+
+    rgb_panel_snapshot_obj_t *it = mp_obj_malloc_with_finaliser(rgb_panel_snapshot_obj_t, &rgb_panel_snapshot_type);
+    it->panel = self;
+    it->copy = NULL;
+    it->pos = 0;
+    it->npx = (size_t)RGB_PANEL_WIDTH(self) * RGB_PANEL_HEIGHT(self);
+    if (args[ARG_copy].u_bool) {
+        size_t size = it->npx * sizeof(uint16_t);
+        it->copy = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (it->copy == NULL) {
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no PSRAM for snapshot copy"));
+        }
+        rgb_panel_lock(pos_args[0]);
+        memcpy(it->copy, self->front_fb, size);
+        rgb_panel_unlock(pos_args[0]);
+        it->fb = it->copy;
+    } else {
+        it->fb = (const uint16_t *)self->front_fb;
+    }
+    it->chunk_size = (size_t)chunk_size & ~(size_t)1;
+    it->width = RGB_PANEL_WIDTH(self);
+    it->encoding = (uint8_t)encoding;
+    it->buf = encoding == RGB_PANEL_SNAPSHOT_RAW ? NULL : m_new(uint8_t, it->chunk_size);
+    return MP_OBJ_FROM_PTR(it);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(rgb_panel_snapshot_chunks_obj, 1, rgb_panel_snapshot_chunks);
+
+/*
+ * lock() / unlock() — hold off the LVGL refresh task while touching widgets.
+ * Recursive; no-ops when lvgl_task is off.  Also usable as `with display:`.
+ * unlock() wakes the task, so changes render without waiting out its sleep.
+ */
+static mp_obj_t rgb_panel_lock(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->lvgl_lock != NULL) {
+        MP_THREAD_GIL_EXIT();
+        xSemaphoreTakeRecursive(self->lvgl_lock, portMAX_DELAY);
+        MP_THREAD_GIL_ENTER();
+    }
+    return self_in;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_lock_obj, rgb_panel_lock);
+
+static mp_obj_t rgb_panel_unlock(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->lvgl_lock != NULL) {
+        xSemaphoreGiveRecursive(self->lvgl_lock);
+        xSemaphoreGive(self->task_wake);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_unlock_obj, rgb_panel_unlock);
+
+static mp_obj_t rgb_panel___exit__(size_t n_args, const mp_obj_t *args) {
+    return rgb_panel_unlock(args[0]);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rgb_panel___exit___obj, 4, 4, rgb_panel___exit__);
+
+/*
+ * boot_times() — microseconds spent in each init() stage, plus the total and
+ * the time from init() start to the first frame actually shown
+ * (first_frame is None until LVGL has rendered and swapped once).
+ */
+static const qstr rgb_panel_boot_names[RGB_PANEL_BOOT_STAGES] = {
+    [RGB_PANEL_BOOT_ALLOC]        = MP_QSTR_alloc,
+    [RGB_PANEL_BOOT_SPI_SETUP]    = MP_QSTR_spi_setup,
+    [RGB_PANEL_BOOT_INIT_CMDS]    = MP_QSTR_init_cmds,
+    [RGB_PANEL_BOOT_PANEL_CREATE] = MP_QSTR_panel_create,
+    [RGB_PANEL_BOOT_PANEL_INIT]   = MP_QSTR_panel_init,
+    [RGB_PANEL_BOOT_BACKLIGHT]    = MP_QSTR_backlight,
+    [RGB_PANEL_BOOT_LVGL]         = MP_QSTR_lvgl,
+    [RGB_PANEL_BOOT_LVGL_TASK]    = MP_QSTR_lvgl_task,
+};
+
+static mp_obj_t rgb_panel_boot_times(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t dict = mp_obj_new_dict(RGB_PANEL_BOOT_STAGES + 2);
+    for (int i = 0; i < RGB_PANEL_BOOT_STAGES; i++) {
+        mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(rgb_panel_boot_names[i]),
+                          mp_obj_new_int_from_uint(self->boot_us[i]));
+    }
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_total),
+                      mp_obj_new_int_from_uint((uint32_t)(self->boot_mark_us - self->boot_start_us)));
+    int64_t first = self->isr ? self->isr->first_swap_us : 0;
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_first_frame),
+                      first ? mp_obj_new_int_from_uint((uint32_t)(first - self->boot_start_us)) : mp_const_none);
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_boot_times_obj, rgb_panel_boot_times);
+
+/* bounce_info() — bounce-buffer SRAM use and refill underrun count */
+static mp_obj_t rgb_panel_bounce_info(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t dict = mp_obj_new_dict(4);
+    size_t sram = 2 * (size_t)RGB_PANEL_WIDTH(self) * RGB_PANEL_BB_LINES(self) * sizeof(uint16_t);
+    uint32_t frames = self->isr ? self->isr->bb_frames : 0;
+    uint32_t underruns = self->isr ? self->isr->bb_underruns : 0;
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_lines), MP_OBJ_NEW_SMALL_INT(RGB_PANEL_BB_LINES(self)));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_sram_bytes), mp_obj_new_int_from_uint(sram));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_frames), mp_obj_new_int_from_uint(frames));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_underruns), mp_obj_new_int_from_uint(underruns));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_bounce_info_obj, rgb_panel_bounce_info);
+
+/*
+ * sync_info() — double-buffer sync copy counters (last frame + totals), and
+ * the bytes still waiting for the swap to latch (pending)
+ */
+static mp_obj_t rgb_panel_sync_info(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    uint32_t pending = 0;
+    for (uint8_t i = 0; i < self->sync_count; i++) {
+        pending += rgb_panel_area_px(&self->sync_rects[i]) * sizeof(uint16_t);
+    }
+    mp_obj_t dict = mp_obj_new_dict(8);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_frames), mp_obj_new_int_from_uint(self->sync_frames));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_areas), mp_obj_new_int_from_uint(self->sync_areas_last));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_rects), mp_obj_new_int_from_uint(self->sync_rects_last));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bytes), mp_obj_new_int_from_uint(self->sync_bytes_last));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_dirty_bytes), mp_obj_new_int_from_uint(self->sync_dirty_last));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bytes_total), mp_obj_new_int_from_ull(self->sync_bytes_total));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_dirty_bytes_total), mp_obj_new_int_from_ull(self->sync_dirty_total));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_pending), mp_obj_new_int_from_uint(pending));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_sync_info_obj, rgb_panel_sync_info);
+
+/* refresh_info() — frames scanned out, measured vs nominal refresh rate */
+static mp_obj_t rgb_panel_refresh_info(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    rgb_panel_isr_ctx_t *isr = self->isr;
+    mp_obj_t dict = mp_obj_new_dict(5);
+    uint32_t frames = isr ? isr->frames : 0;
+    uint32_t swaps = isr ? isr->swaps : 0;
+    mp_float_t hz = (isr && isr->frame_avg_us) ? (mp_float_t)1000000 / isr->frame_avg_us : 0;
+    mp_float_t nominal = (isr && isr->frame_period_us) ? (mp_float_t)1000000 / isr->frame_period_us : 0;
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_frames), mp_obj_new_int_from_uint(frames));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_swaps), mp_obj_new_int_from_uint(swaps));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_hz), mp_obj_new_float(hz));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_nominal_hz), mp_obj_new_float(nominal));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_refresh_ms), mp_obj_new_int_from_uint(self->refr_ms));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_refresh_info_obj, rgb_panel_refresh_info);
+
+/*
+ * refresh_period(ms=None) — period of LVGL's refresh timer, i.e. how often
+ * invalidated areas are redrawn (LV_DEF_REFR_PERIOD by default).  Short while
+ * the UI is changing, long to coalesce rare updates; either way an idle UI
+ * costs nothing, as the timer pauses itself until the next invalidation.
+ * Can be set before init().  Returns the period in effect.
+ */
+static mp_obj_t rgb_panel_refresh_period(size_t n_args, const mp_obj_t *args) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    if (n_args > 1 && args[1] != mp_const_none) {
+        mp_int_t ms = mp_obj_get_int(args[1]);
+        if (ms < 1 || ms > 60000) {
+            mp_raise_ValueError(MP_ERROR_TEXT("refresh period must be 1..60000 ms"));
+        }
+        self->refr_ms = (uint32_t)ms;
+        if (self->lv_disp != NULL) {
+            rgb_panel_lock(args[0]);
+            lv_timer_set_period(lv_display_get_refr_timer(self->lv_disp), self->refr_ms);
+            rgb_panel_unlock(args[0]);
+        }
+    }
+    return mp_obj_new_int_from_uint(self->refr_ms);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rgb_panel_refresh_period_obj, 1, 2, rgb_panel_refresh_period);
+
+/* C pointer behind a binding object (lv.obj, lv.font_t, ...): the bindings
+ * expose it through the buffer protocol as a pointer-sized buffer */
+static void *rgb_panel_lv_ptr(mp_obj_t obj_in) {
+    mp_buffer_info_t bufinfo;
+    void *ptr;
+    mp_get_buffer_raise(obj_in, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.len != sizeof(ptr)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("expected an LVGL object"));
+    }
+    memcpy(&ptr, bufinfo.buf, sizeof(ptr));
+    if (ptr == NULL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("NULL LVGL object"));
+    }
+    return ptr;
+}
+
+/*
+ * cached_font(font) — glyph-caching copy of an LVGL font, as a bytearray over
+ * the copied lv_font_t for lv.font_t.__cast__().  The same font always gives
+ * the same copy; without a glyph cache the font itself comes back.
+ */
+static mp_obj_t rgb_panel_cached_font(mp_obj_t font_in) {
+    #if RGB_PANEL_GLYPH_CACHE_ENTRIES > 0
+    rgb_panel_glyphs_t *gc = &rgb_panel_glyphs;
+    const lv_font_t *font = rgb_panel_lv_ptr(font_in);
+    if (font->get_glyph_bitmap == NULL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("font has no bitmaps"));
+    }
+
+    int i;
+    for (i = 0; i < gc->n_fonts; i++) {
+        if (font == gc->orig[i] || font == &gc->fonts[i]) {
+            break;
+        }
+    }
+    if (i == gc->n_fonts) {
+        if (i == RGB_PANEL_GLYPH_FONTS) {
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("too many cached fonts"));
+        }
+        if (gc->slots == NULL) {
+            gc->slots = heap_caps_calloc(RGB_PANEL_GLYPH_CACHE_ENTRIES, sizeof(rgb_panel_glyph_t),
+                                         MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            if (gc->slots == NULL) {
+                mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no internal RAM for glyph cache"));
+            }
+        }
+        gc->fonts[i] = *font;
+        gc->fonts[i].get_glyph_bitmap = rgb_panel_glyph_bitmap;
+        gc->orig[i] = font;
+        gc->n_fonts++;
+    }
+    return mp_obj_new_bytearray_by_ref(sizeof(lv_font_t), &gc->fonts[i]);
+    #else
+    return font_in;
+    #endif
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_cached_font_obj, rgb_panel_cached_font);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Batched widget updates                                                   */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/* apply() properties, exported as PROP_* */
+enum {
+    RGB_PANEL_PROP_TEXT,            /* str, labels only */
+    RGB_PANEL_PROP_TEXT_COLOR,      /* 0xRRGGBB */
+    RGB_PANEL_PROP_BG_COLOR,        /* 0xRRGGBB */
+    RGB_PANEL_PROP_BG_OPA,          /* 0..255 */
+    RGB_PANEL_PROP_HIDDEN,          /* bool */
+};
+
+static bool rgb_panel_local_color_is(lv_obj_t *obj, lv_style_prop_t prop, lv_color_t c) {
+    lv_style_value_t cur;
+    return lv_obj_get_local_style_prop(obj, prop, &cur, 0) == LV_STYLE_RES_FOUND && lv_color_eq(cur.color, c);
+}
+
+/* One update; false when it would not have changed anything */
+static bool rgb_panel_apply_one(lv_obj_t *obj, mp_int_t prop, mp_obj_t value) {
+    switch (prop) {
+        case RGB_PANEL_PROP_TEXT: {
+            if (!lv_obj_check_type(obj, &lv_label_class)) {
+                mp_raise_TypeError(MP_ERROR_TEXT("PROP_TEXT needs a label"));
+            }
+            const char *text = mp_obj_str_get_str(value);
+            const char *cur = lv_label_get_text(obj);
+            if (cur != NULL && strcmp(cur, text) == 0) {
+                return false;
+            }
+            lv_label_set_text(obj, text);
+            return true;
+        }
+        case RGB_PANEL_PROP_TEXT_COLOR: {
+            lv_color_t c = lv_color_hex((uint32_t)mp_obj_get_int(value));
+            if (rgb_panel_local_color_is(obj, LV_STYLE_TEXT_COLOR, c)) {
+                return false;
+            }
+            lv_obj_set_style_text_color(obj, c, 0);
+            return true;
+        }
+        case RGB_PANEL_PROP_BG_COLOR: {
+            lv_color_t c = lv_color_hex((uint32_t)mp_obj_get_int(value));
+            if (rgb_panel_local_color_is(obj, LV_STYLE_BG_COLOR, c)) {
+                return false;
+            }
+            lv_obj_set_style_bg_color(obj, c, 0);
+            return true;
+        }
+        case RGB_PANEL_PROP_BG_OPA: {
+            mp_int_t opa = mp_obj_get_int(value);
+            if (opa < 0 || opa > 255) {
+                mp_raise_ValueError(MP_ERROR_TEXT("opacity must be 0..255"));
+            }
+            lv_style_value_t cur;
+            if (lv_obj_get_local_style_prop(obj, LV_STYLE_BG_OPA, &cur, 0) == LV_STYLE_RES_FOUND &&
+                cur.num == opa) {
+                return false;
+            }
+            lv_obj_set_style_bg_opa(obj, (lv_opa_t)opa, 0);
+            return true;
+        }
+        case RGB_PANEL_PROP_HIDDEN: {
+            bool hide = mp_obj_is_true(value);
+            if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == hide) {
+                return false;
+            }
+            if (hide) {
+                lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+            } else {
+                lv_obj_remove_flag(obj, LV_OBJ_FLAG_HIDDEN);
+            }
+            return true;
+        }
+        default:
+            mp_raise_ValueError(MP_ERROR_TEXT("unknown property"));
+    }
+}
+
+/*
+ * apply(updates) — a sequence of (obj, prop, value) tuples, prop one of the
+ * PROP_* constants, applied in one call under the display lock.  Through the
+ * bindings every setter invalidates its widget (a label also re-lays out its
+ * text) even when the value is unchanged; here those updates are skipped, and
+ * LVGL joins the areas of the rest at the next refresh.  Colours are plain
+ * 0xRRGGBB ints and styles go to the default selector.  Returns the number of
+ * updates that changed something.
+ */
+static mp_obj_t rgb_panel_apply(mp_obj_t self_in, mp_obj_t updates_in) {
+    size_t n;
+    mp_obj_t *updates;
+    mp_obj_get_array(updates_in, &n, &updates);
+
+    uint32_t changed = 0;
+    rgb_panel_lock(self_in);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        for (size_t i = 0; i < n; i++) {
+            mp_obj_t *u;
+            mp_obj_get_array_fixed_n(updates[i], 3, &u);
+            changed += rgb_panel_apply_one(rgb_panel_lv_ptr(u[0]), mp_obj_get_int(u[1]), u[2]);
+        }
+        nlr_pop();
+    } else {
+        /* Updates before the bad one stay applied */
+        rgb_panel_unlock(self_in);
+        nlr_jump(nlr.ret_val);
+    }
+    rgb_panel_unlock(self_in);
+    return mp_obj_new_int_from_uint(changed);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(rgb_panel_apply_obj, rgb_panel_apply);
+
+static mp_obj_t rgb_panel_cache_dict(rgb_panel_cache_probe_t *p) {
+    mp_obj_t dict = mp_obj_new_dict(4);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_hits), mp_obj_new_int_from_uint(p->hits));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_misses), mp_obj_new_int_from_uint(p->misses));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_size),
+                      mp_obj_new_int_from_uint(p->cache ? lv_cache_get_size(p->cache, NULL) : 0));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_max_size),
+                      mp_obj_new_int_from_uint(p->cache ? lv_cache_get_max_size(p->cache, NULL) : 0));
+    return dict;
+}
+
+/* Cache counters for stats(): image (bytes), header and glyph (entries) */
+static mp_obj_t rgb_panel_caches_dict(void) {
+    mp_obj_t dict = mp_obj_new_dict(3);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_image),
+                      rgb_panel_cache_dict(&rgb_panel_cache_probes[RGB_PANEL_CACHE_IMAGE]));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_header),
+                      rgb_panel_cache_dict(&rgb_panel_cache_probes[RGB_PANEL_CACHE_HEADER]));
+    #if RGB_PANEL_GLYPH_CACHE_ENTRIES > 0
+    rgb_panel_glyphs_t *gc = &rgb_panel_glyphs;
+    mp_obj_t glyph = mp_obj_new_dict(7);
+    mp_obj_dict_store(glyph, MP_OBJ_NEW_QSTR(MP_QSTR_hits), mp_obj_new_int_from_uint(gc->hits));
+    mp_obj_dict_store(glyph, MP_OBJ_NEW_QSTR(MP_QSTR_misses), mp_obj_new_int_from_uint(gc->misses));
+    mp_obj_dict_store(glyph, MP_OBJ_NEW_QSTR(MP_QSTR_evictions), mp_obj_new_int_from_uint(gc->evictions));
+    mp_obj_dict_store(glyph, MP_OBJ_NEW_QSTR(MP_QSTR_size), mp_obj_new_int_from_uint(gc->used));
+    mp_obj_dict_store(glyph, MP_OBJ_NEW_QSTR(MP_QSTR_max_size), MP_OBJ_NEW_SMALL_INT(RGB_PANEL_GLYPH_CACHE_ENTRIES));
+    mp_obj_dict_store(glyph, MP_OBJ_NEW_QSTR(MP_QSTR_bytes), mp_obj_new_int_from_uint(gc->bytes));
+    mp_obj_dict_store(glyph, MP_OBJ_NEW_QSTR(MP_QSTR_fonts), MP_OBJ_NEW_SMALL_INT(gc->n_fonts));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_glyph), glyph);
+    #else
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_glyph), mp_const_none);
+    #endif
+    return dict;
+}
+
+static void rgb_panel_caches_reset(void) {
+    for (int i = 0; i < RGB_PANEL_CACHE_COUNT; i++) {
+        rgb_panel_cache_probes[i].hits = rgb_panel_cache_probes[i].misses = 0;
+    }
+    #if RGB_PANEL_GLYPH_CACHE_ENTRIES > 0
+    taskENTER_CRITICAL(&rgb_panel_glyphs.lock);
+    rgb_panel_glyphs.hits = rgb_panel_glyphs.misses = rgb_panel_glyphs.evictions = 0;
+    taskEXIT_CRITICAL(&rgb_panel_glyphs.lock);
+    #endif
+}
+
+static mp_obj_t rgb_panel_stats_dict(const rgb_panel_stats_t *st, int64_t now) {
+    uint32_t ms = (uint32_t)((now - st->since_us) / 1000);
+    mp_float_t fps = ms ? (mp_float_t)st->renders * 1000 / ms : 0;
+    mp_obj_t dict = mp_obj_new_dict(16);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_ms), mp_obj_new_int_from_uint(ms));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_refreshes), mp_obj_new_int_from_uint(st->refreshes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_renders), mp_obj_new_int_from_uint(st->renders));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fps), mp_obj_new_float(fps));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_flushes), mp_obj_new_int_from_uint(st->flushes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_px), mp_obj_new_int_from_ull(st->px_flushed));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bytes_copied), mp_obj_new_int_from_ull(st->bytes_copied));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_copy_us), mp_obj_new_int_from_ull(st->copy_us));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_flush_us), mp_obj_new_int_from_ull(st->flush_us));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_flush_avg_us),
+                      mp_obj_new_int_from_uint(st->flushes ? (uint32_t)(st->flush_us / st->flushes) : 0));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_gap_avg_us),
+                      mp_obj_new_int_from_uint(st->refreshes > 1 ? (uint32_t)(st->gap_us / (st->refreshes - 1)) : 0));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_gap_max_us), mp_obj_new_int_from_uint(st->gap_max_us));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_swaps), mp_obj_new_int_from_uint(st->swaps));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_swap_avg_us),
+                      mp_obj_new_int_from_uint(st->swaps ? (uint32_t)(st->swap_us / st->swaps) : 0));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_swap_max_us), mp_obj_new_int_from_uint(st->swap_max_us));
+    return dict;
+}
+
+/* stats() — render counters since init() and since the previous stats() call,
+ * plus the cache counters (cumulative) */
+static mp_obj_t rgb_panel_stats(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    int64_t now = esp_timer_get_time();
+    mp_obj_t dict = mp_obj_new_dict(3);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_total),
+                      rgb_panel_stats_dict(&self->stats[RGB_PANEL_STATS_TOTAL], now));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_window),
+                      rgb_panel_stats_dict(&self->stats[RGB_PANEL_STATS_WINDOW], now));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_cache), rgb_panel_caches_dict());
+    rgb_panel_stats_reset(self, RGB_PANEL_STATS_WINDOW);
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_stats_obj, rgb_panel_stats);
+
+/* reset_stats() — zero both the cumulative and the windowed counters */
+static mp_obj_t rgb_panel_reset_stats(mp_obj_t self_in) {
+    rgb_panel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    rgb_panel_stats_reset(self, RGB_PANEL_STATS_TOTAL);
+    rgb_panel_stats_reset(self, RGB_PANEL_STATS_WINDOW);
+    rgb_panel_caches_reset();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_reset_stats_obj, rgb_panel_reset_stats);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Pool statistics                                                          */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/* pool_info() — usage of the LVGL draw buffer pools (None when not in use) */
+static mp_obj_t rgb_panel_pool_dict(const rgb_panel_pool_t *pool) {
+    if (pool->heap == NULL) {
+        return mp_const_none;
+    }
+    multi_heap_info_t info;
+    multi_heap_get_info(pool->heap, &info);
+    size_t free_bytes = info.total_free_bytes;
+    mp_obj_t dict = mp_obj_new_dict(7);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_size), mp_obj_new_int_from_uint(pool->size));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_used), mp_obj_new_int_from_uint(info.total_allocated_bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_free), mp_obj_new_int_from_uint(free_bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_min_free), mp_obj_new_int_from_uint(info.minimum_free_bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_largest), mp_obj_new_int_from_uint(info.largest_free_block));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_blocks), mp_obj_new_int_from_uint(info.allocated_blocks));
+    /* Share of free memory not usable for the largest request */
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_frag_pct),
+                      MP_OBJ_NEW_SMALL_INT(free_bytes ? 100 - (int)((uint64_t)info.largest_free_block * 100 / free_bytes) : 0));
+    return dict;
+}
+
+static mp_obj_t rgb_panel_pool_info(void) {
+    mp_obj_t dict = mp_obj_new_dict(3);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_psram), rgb_panel_pool_dict(&rgb_panel_pools.psram));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_sram), rgb_panel_pool_dict(&rgb_panel_pools.sram));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fallbacks), mp_obj_new_int_from_uint(rgb_panel_pools.fallbacks));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(rgb_panel_pool_info_obj, rgb_panel_pool_info);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Blend kernels                                                            */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/* blend_info() — how often LVGL took each LV_DRAW_SW_ASM_CUSTOM hook */
+static mp_obj_t rgb_panel_blend_info(void) {
+    mp_obj_t dict = mp_obj_new_dict(5);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_hooks), mp_obj_new_bool(RGB_PANEL_LVGL_PIE));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fill), mp_obj_new_int_from_uint(rgb565_pie_counts.fill));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fill_opa), mp_obj_new_int_from_uint(rgb565_pie_counts.fill_opa));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fill_mask), mp_obj_new_int_from_uint(rgb565_pie_counts.fill_mask));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_copy), mp_obj_new_int_from_uint(rgb565_pie_counts.copy));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(rgb_panel_blend_info_obj, rgb_panel_blend_info);
+
+/*
+ * LVGL's generic RGB565 loops (lv_draw_sw_blend_to_rgb565.c), reproduced so
+ * the benchmark can run them while the hooks are compiled in.
+ */
+enum { BENCH_FILL, BENCH_FILL_OPA, BENCH_FILL_MASK, BENCH_COPY, BENCH_COUNT };
+
+typedef struct {
+    uint16_t *dst;
+    const uint16_t *src;
+    const uint8_t *mask;
+    int32_t w, h, stride, src_stride;
+    uint16_t color;
+} rgb565_bench_t;
+
+static void rgb565_generic(const rgb565_bench_t *b, int kernel) {
+    uint16_t *d = b->dst;
+    const uint16_t *s = b->src;
+    const uint8_t *m = b->mask;
+    for (int32_t y = 0; y < b->h; y++) {
+        switch (kernel) {
+            case BENCH_FILL:
+                for (int32_t x = 0; x < b->w; x++) d[x] = b->color;
+                break;
+            case BENCH_FILL_OPA:
+                for (int32_t x = 0; x < b->w; x++) d[x] = lv_color_16_16_mix(b->color, d[x], LV_OPA_50);
+                break;
+            case BENCH_FILL_MASK:
+                for (int32_t x = 0; x < b->w; x++) d[x] = lv_color_16_16_mix(b->color, d[x], m[x]);
+                m += b->w;
+                break;
+            default:
+                lv_memcpy(d, s, (size_t)b->w * sizeof(uint16_t));
+                s = (const uint16_t *)((const uint8_t *)s + b->src_stride);
+                break;
+        }
+        d = (uint16_t *)((uint8_t *)d + b->stride);
+    }
+}
+
+static void rgb565_kernel(const rgb565_bench_t *b, int kernel) {
+    switch (kernel) {
+        case BENCH_FILL:
+            rgb565_pie_fill(b->dst, b->w, b->h, b->stride, b->color);
+            break;
+        case BENCH_FILL_OPA:
+            rgb565_pie_fill_opa(b->dst, b->w, b->h, b->stride, b->color, LV_OPA_50);
+            break;
+        case BENCH_FILL_MASK:
+            rgb565_pie_fill_mask(b->dst, b->w, b->h, b->stride, b->color, b->mask, b->w);
+            break;
+        default:
+            rgb565_pie_copy(b->dst, b->stride, b->src, b->src_stride, b->w, b->h);
+            break;
+    }
+}
+
+/* Same pseudo-random backdrop for both runs of a kernel */
+static void rgb565_bench_backdrop(uint16_t *buf, size_t px) {
+    uint32_t x = 0x2545F491;
+    for (size_t i = 0; i < px; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (uint16_t)(i & 64 ? 0x0000 : x);  /* runs of one colour, like UI backgrounds */
+    }
+}
+
+/*
+ * blend_bench(width=480, height=40, rounds=20, psram=False)
+ *
+ * Times each kernel against LVGL's generic loop on a width x height area
+ * (one PARTIAL draw buffer by default; psram=True for a DIRECT framebuffer),
+ * and checks both produce the same pixels.  The destination starts one pixel
+ * past a 16-byte boundary and the source three, so the unaligned edges are
+ * exercised too.  Returns {kernel: (generic_us, kernel_us, match)}.
+ */
+static mp_obj_t rgb_panel_blend_bench(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_width, ARG_height, ARG_rounds, ARG_psram };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width,  MP_ARG_INT,  {.u_int = 480} },
+        { MP_QSTR_height, MP_ARG_INT,  {.u_int = 40} },
+        { MP_QSTR_rounds, MP_ARG_INT,  {.u_int = 20} },
+        { MP_QSTR_psram,  MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int32_t w = args[ARG_width].u_int;
+    int32_t h = args[ARG_height].u_int;
+    mp_int_t rounds = args[ARG_rounds].u_int;
+    if (w < 1 || w > 2048 || h < 1 || h > 2048 || rounds < 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bad bench size"));
+    }
+
+    /* Rows padded by 8 pixels so every row keeps the same misalignment */
+    int32_t stride_px = w + 8;
+    size_t px = (size_t)stride_px * (size_t)h + 8;
+    uint32_t caps = (args[ARG_psram].u_bool ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+    uint16_t *ref = heap_caps_aligned_alloc(16, px * sizeof(uint16_t), caps);
+    uint16_t *out = heap_caps_aligned_alloc(16, px * sizeof(uint16_t), caps);
+    uint16_t *src = heap_caps_aligned_alloc(16, px * sizeof(uint16_t), caps);
+    uint8_t *mask = heap_caps_malloc((size_t)w * (size_t)h, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ref == NULL || out == NULL || src == NULL || mask == NULL) {
+        heap_caps_free(ref);
+        heap_caps_free(out);
+        heap_caps_free(src);
+        heap_caps_free(mask);
+        mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no memory for blend bench"));
+    }
+    rgb565_bench_backdrop(src, px);
+    for (size_t i = 0; i < (size_t)w * (size_t)h; i++) {
+        /* Glyph-like coverage: mostly 0 or 255 with antialiased edges */
+        uint32_t v = (i * 2654435761U) >> 24;
+        mask[i] = v < 96 ? 0 : v > 192 ? 255 : (uint8_t)v;
+    }
+
+    static const qstr names[BENCH_COUNT] = {
+        MP_QSTR_fill, MP_QSTR_fill_opa, MP_QSTR_fill_mask, MP_QSTR_copy,
+    };
+    int64_t us[BENCH_COUNT][2];
+    bool match[BENCH_COUNT];
+    for (int k = 0; k < BENCH_COUNT; k++) {
+        rgb565_bench_t ref_b = {
+            .dst = ref + 1, .src = src + 3, .mask = mask, .w = w, .h = h,
+            .stride = stride_px * (int32_t)sizeof(uint16_t),
+            .src_stride = stride_px * (int32_t)sizeof(uint16_t),
+            .color = 0x3A6F,
+        };
+        rgb565_bench_t out_b = ref_b;
+        out_b.dst = out + 1;
+
+        rgb565_bench_backdrop(ref, px);
+        rgb565_bench_backdrop(out, px);
+        rgb565_generic(&ref_b, k);
+        rgb565_kernel(&out_b, k);
+        match[k] = memcmp(ref, out, px * sizeof(uint16_t)) == 0;
+
+        int64_t t0 = esp_timer_get_time();
+        for (mp_int_t r = 0; r < rounds; r++) rgb565_generic(&ref_b, k);
+        int64_t t1 = esp_timer_get_time();
+        for (mp_int_t r = 0; r < rounds; r++) rgb565_kernel(&out_b, k);
+        int64_t t2 = esp_timer_get_time();
+        us[k][0] = (t1 - t0) / rounds;
+        us[k][1] = (t2 - t1) / rounds;
+    }
+    heap_caps_free(ref);
+    heap_caps_free(out);
+    heap_caps_free(src);
+    heap_caps_free(mask);
+
+    mp_obj_t dict = mp_obj_new_dict(BENCH_COUNT);
+    for (int k = 0; k < BENCH_COUNT; k++) {
+        mp_obj_t row[3] = {
+            mp_obj_new_int((mp_int_t)us[k][0]),
+            mp_obj_new_int((mp_int_t)us[k][1]),
+            mp_obj_new_bool(match[k]),
+        };
+        mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(names[k]), mp_obj_new_tuple(3, row));
+    }
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(rgb_panel_blend_bench_obj, 0, rgb_panel_blend_bench);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Trace functions                                                          */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/* trace_start(capacity=1024) — clear the trace ring and start recording */
+static mp_obj_t rgb_panel_trace_start(size_t n_args, const mp_obj_t *args) {
+    rgb_panel_trace_t *tr = &rgb_panel_trace_ring;
+    mp_int_t want = n_args > 0 ? mp_obj_get_int(args[0]) : 1024;
+    if (want < 16 || want > 16384) {
+        mp_raise_ValueError(MP_ERROR_TEXT("capacity must be 16..16384"));
+    }
+    uint32_t capacity = 16;
+    while (capacity < (uint32_t)want) capacity <<= 1;
+
+    tr->enabled = false;
+    if (tr->events == NULL || tr->capacity != capacity) {
+        heap_caps_free(tr->events);
+        tr->capacity = 0;
+        /* Internal RAM: the RGB ISR emits with the flash cache possibly off */
+        tr->events = heap_caps_malloc(capacity * sizeof(rgb_panel_trace_ev_t),
+                                      MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (tr->events == NULL) {
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no memory for trace ring"));
+        }
+        tr->capacity = capacity;
+    }
+    tr->head = 0;
+    __atomic_store_n(&tr->enabled, true, __ATOMIC_RELEASE);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rgb_panel_trace_start_obj, 0, 1, rgb_panel_trace_start);
+
+/* trace_stop() — stop recording; what was recorded stays readable */
+static mp_obj_t rgb_panel_trace_stop(void) {
+    rgb_panel_trace_ring.enabled = false;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(rgb_panel_trace_stop_obj, rgb_panel_trace_stop);
+
+/*
+ * trace(id, arg=0, ticks_us=None) — record an event now, or at ticks_us, a
+ * time.ticks_us() value taken earlier (e.g. a ble_notify arrival stamp).
+ */
+static mp_obj_t rgb_panel_trace_emit(size_t n_args, const mp_obj_t *args) {
+    if (!rgb_panel_trace_ring.enabled) return mp_const_none;
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    uint32_t t_us = now;
+    if (n_args > 2 && args[2] != mp_const_none) {
+        /* ticks_us is esp_timer masked to a small int: step back by the age */
+        mp_uint_t ticks = mp_obj_get_int(args[2]);
+        t_us = now - ((now - ticks) & MP_SMALL_INT_POSITIVE_MASK);
+    }
+    rgb_panel_trace_at(mp_obj_get_int(args[0]), n_args > 1 ? mp_obj_get_int(args[1]) : 0, t_us);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rgb_panel_trace_emit_obj, 1, 3, rgb_panel_trace_emit);
+
+/*
+ * trace_read() — (events, lost): the recorded events oldest first as packed
+ * little-endian records (t_us:u32 id:u16 reserved:u16 arg:i32), and how many
+ * older ones were overwritten.  Recording pauses while copying.
+ */
+static mp_obj_t rgb_panel_trace_read(void) {
+    rgb_panel_trace_t *tr = &rgb_panel_trace_ring;
+    bool was_enabled = tr->enabled;
+    tr->enabled = false;
+    uint32_t head = __atomic_load_n(&tr->head, __ATOMIC_ACQUIRE);
+    uint32_t n = head < tr->capacity ? head : tr->capacity;
+    uint32_t first = head - n;
+
+    vstr_t vstr;
+    vstr_init_len(&vstr, n * sizeof(rgb_panel_trace_ev_t));
+    for (uint32_t i = 0; i < n; i++) {
+        memcpy(vstr.buf + i * sizeof(rgb_panel_trace_ev_t),
+               &tr->events[(first + i) & (tr->capacity - 1)], sizeof(rgb_panel_trace_ev_t));
+    }
+    tr->enabled = was_enabled;
+    mp_obj_t items[2] = {
+        mp_obj_new_bytes_from_vstr(&vstr),
+        mp_obj_new_int_from_uint(first),
+    };
+    return mp_obj_new_tuple(2, items);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(rgb_panel_trace_read_obj, rgb_panel_trace_read);
+
+#if RGB_PANEL_SIM
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Host simulation                                                          */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * sim_advance(ms) — move the simulated clock, which is LVGL's tick, on by
+ * ms.  Rendering still happens in lv.task_handler() or lv.refr_now(), called
+ * by the script.
+ */
+static mp_obj_t rgb_panel_sim_advance_fn(mp_obj_t ms_in) {
+    mp_int_t ms = mp_obj_get_int(ms_in);
+    if (ms < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ms must be >= 0"));
+    }
+    rgb_panel_sim_advance((uint64_t)ms * 1000);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(rgb_panel_sim_advance_obj, rgb_panel_sim_advance_fn);
+
+/* sim_info() — what reached the simulated panel: VSYNCs, swaps, bitmap copies */
+static mp_obj_t rgb_panel_sim_info(void) {
+    const rgb_panel_sim_counts_t *c = &rgb_panel_sim_counts;
+    mp_obj_t dict = mp_obj_new_dict(4);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_vsyncs), mp_obj_new_int_from_uint(c->vsyncs));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_swaps), mp_obj_new_int_from_uint(c->swaps));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bitmaps), mp_obj_new_int_from_uint(c->bitmaps));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bitmap_bytes), mp_obj_new_int_from_ull(c->bitmap_bytes));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(rgb_panel_sim_info_obj, rgb_panel_sim_info);
+#endif /* RGB_PANEL_SIM */
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Digit atlas                                                              */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/*
+ * DigitAtlas(font, color, chars=...) renders a small character set once, as
+ * one RGB565A8 image per glyph in internal RAM.  attach(obj) draws the text
+ * given to set_text() centred in obj's content area, after obj's own drawing;
+ * each character is then one image blit instead of a trip through the font
+ * engine and the label layout.  Meant for a value that changes many times a
+ * second in one place, such as the live weight.  Kerning is not applied.
+ *
+ * The drawn object keeps the atlas alive (it is the event user_data, and LVGL
+ * objects live in the GC heap); deleting the object detaches it.
+ */
+#define DIGIT_ATLAS_MAX_CHARS 24
+#define DIGIT_ATLAS_MAX_TEXT  24
+
+typedef struct {
+    lv_image_dsc_t img;             /* box_w x box_h, empty for blanks */
+    int16_t x;                      /* box offset inside the line */
+    int16_t y;
+    uint16_t adv;
+    char ch;
+} digit_atlas_cell_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    digit_atlas_cell_t cells[DIGIT_ATLAS_MAX_CHARS];
+    int n_cells;
+    int32_t line_height;
+    uint8_t *mem;                   /* all glyph planes, internal RAM */
+    size_t mem_size;
+    lv_obj_t *obj;
+    uint8_t text[DIGIT_ATLAS_MAX_TEXT];   /* cell indices */
+    int text_len;
+    int32_t text_w;
+} digit_atlas_obj_t;
+
+static const mp_obj_type_t digit_atlas_type;
+
+static const digit_atlas_cell_t *digit_atlas_cell(const digit_atlas_obj_t *self, char ch) {
+    for (int i = 0; i < self->n_cells; i++) {
+        if (self->cells[i].ch == ch) {
+            return &self->cells[i];
+        }
+    }
+    return NULL;
+}
+
+/* Glyph box at LVGL's label position: top = line_height - base_line - box_h - ofs_y */
+static void digit_atlas_render(digit_atlas_obj_t *self, const lv_font_t *font, uint16_t color,
+                               const char *chars, size_t n) {
+    lv_font_glyph_dsc_t g[DIGIT_ATLAS_MAX_CHARS];
+    size_t total = 0;
+    self->line_height = lv_font_get_line_height(font);
+    for (size_t i = 0; i < n; i++) {
+        memset(&g[i], 0, sizeof(g[i]));
+        if (!lv_font_get_glyph_dsc(font, &g[i], (uint8_t)chars[i], 0) || g[i].is_placeholder) {
+            mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("font has no glyph for '%c'"), chars[i]);
+        }
+        total += (size_t)g[i].box_w * g[i].box_h * 3;
+    }
+
+    self->mem = heap_caps_malloc(total ? total : 1, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (self->mem == NULL) {
+        mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no internal RAM for digit atlas"));
+    }
+    self->mem_size = total;
+
+    uint8_t *p = self->mem;
+    for (size_t i = 0; i < n; i++) {
+        digit_atlas_cell_t *cell = &self->cells[i];
+        uint32_t w = g[i].box_w, h = g[i].box_h;
+        cell->ch = chars[i];
+        cell->adv = g[i].adv_w;
+        cell->x = g[i].ofs_x;
+        cell->y = (int16_t)(self->line_height - font->base_line - (int32_t)h - g[i].ofs_y);
+        if (w == 0 || h == 0) {
+            continue;
+        }
+
+        /* Colour plane, then the A8 plane expanded by the font */
+        uint16_t *px = (uint16_t *)p;
+        uint8_t *alpha = p + w * h * 2;
+        for (uint32_t k = 0; k < w * h; k++) {
+            px[k] = color;
+        }
+        lv_draw_buf_t *a8 = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_A8, 0);
+        if (a8 == NULL) {
+            heap_caps_free(self->mem);
+            self->mem = NULL;
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("no memory for glyph"));
+        }
+        const lv_draw_buf_t *bm = lv_font_get_glyph_bitmap(&g[i], a8);
+        for (uint32_t y = 0; y < h; y++) {
+            if (bm != NULL) {
+                memcpy(alpha + y * w, bm->data + y * bm->header.stride, w);
+            } else {
+                memset(alpha + y * w, 0, w);
+            }
+        }
+        lv_font_glyph_release_draw_data(&g[i]);
+        lv_draw_buf_destroy(a8);
+
+        cell->img.header.magic = LV_IMAGE_HEADER_MAGIC;
+        cell->img.header.cf = LV_COLOR_FORMAT_RGB565A8;
+        cell->img.header.w = w;
+        cell->img.header.h = h;
+        cell->img.header.stride = w * 2;
+        cell->img.data_size = w * h * 3;
+        cell->img.data = p;
+        p += w * h * 3;
+    }
+    self->n_cells = (int)n;
+}
+
+static void digit_atlas_draw_cb(lv_event_t *e) {
+    digit_atlas_obj_t *self = lv_event_get_user_data(e);
+    if (self->obj == NULL || self->text_len == 0) {
+        return;
+    }
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_area_t content;
+    lv_obj_get_content_coords(self->obj, &content);
+    int32_t x = content.x1 + (lv_area_get_width(&content) - self->text_w) / 2;
+    int32_t y = content.y1;
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.opa = lv_obj_get_style_text_opa(self->obj, LV_PART_MAIN);
+    for (int i = 0; i < self->text_len; i++) {
+        const digit_atlas_cell_t *cell = &self->cells[self->text[i]];
+        if (cell->img.data != NULL) {
+            lv_area_t area = {
+                .x1 = x + cell->x,
+                .y1 = y + cell->y,
+                .x2 = x + cell->x + (int32_t)cell->img.header.w - 1,
+                .y2 = y + cell->y + (int32_t)cell->img.header.h - 1,
+            };
+            dsc.src = &cell->img;
+            lv_draw_image(layer, &dsc, &area);
+        }
+        x += cell->adv;
+    }
+}
+
+static void digit_atlas_delete_cb(lv_event_t *e) {
+    digit_atlas_obj_t *self = lv_event_get_user_data(e);
+    self->obj = NULL;
+}
+
+/* DigitAtlas(font, color, chars="0123456789.-kglb ") */
+static mp_obj_t digit_atlas_make_new(const mp_obj_type_t *type, size_t n_args,
+                                     size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_font, ARG_color, ARG_chars };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_font,  MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_color, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_chars, MP_ARG_KW_ONLY | MP_ARG_OBJ,  {.u_obj = MP_OBJ_NULL} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const lv_font_t *font = rgb_panel_lv_ptr(args[ARG_font].u_obj);
+    size_t n = 17;
+    const char *chars = "0123456789.-kglb ";
+    if (args[ARG_chars].u_obj != MP_OBJ_NULL) {
+        chars = mp_obj_str_get_data(args[ARG_chars].u_obj, &n);
+    }
+    if (n == 0 || n > DIGIT_ATLAS_MAX_CHARS) {
+        mp_raise_ValueError(MP_ERROR_TEXT("chars must have 1 to 24 characters"));
+    }
+    for (size_t i = 0; i < n; i++) {
+        if ((uint8_t)chars[i] >= 0x80) {
+            mp_raise_ValueError(MP_ERROR_TEXT("chars must be ASCII"));
+        }
+    }
+
+    digit_atlas_obj_t *self = mp_obj_malloc_with_finaliser(digit_atlas_obj_t, type);
+    memset(&self->cells, 0, sizeof(*self) - offsetof(digit_atlas_obj_t, cells));
+    uint16_t color = lv_color_to_u16(lv_color_hex((uint32_t)args[ARG_color].u_int));
+    digit_atlas_render(self, font, color, chars, n);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+/* attach(obj) — draw the atlas text over obj from now on */
+static mp_obj_t digit_atlas_attach(mp_obj_t self_in, mp_obj_t obj_in) {
+    digit_atlas_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    lv_obj_t *obj = rgb_panel_lv_ptr(obj_in);
+    if (self->obj != NULL) {
+        lv_obj_remove_event_cb_with_user_data(self->obj, digit_atlas_draw_cb, self);
+        lv_obj_remove_event_cb_with_user_data(self->obj, digit_atlas_delete_cb, self);
+        lv_obj_invalidate(self->obj);
+    }
+    self->obj = obj;
+    lv_obj_add_event_cb(obj, digit_atlas_draw_cb, LV_EVENT_DRAW_MAIN_END, self);
+    lv_obj_add_event_cb(obj, digit_atlas_delete_cb, LV_EVENT_DELETE, self);
+    lv_obj_invalidate(obj);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(digit_atlas_attach_obj, digit_atlas_attach);
+
+/* set_text(text) — every character must be in the atlas */
+static mp_obj_t digit_atlas_set_text(mp_obj_t self_in, mp_obj_t text_in) {
+    digit_atlas_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t len;
+    const char *text = mp_obj_str_get_data(text_in, &len);
+    if (len > DIGIT_ATLAS_MAX_TEXT) {
+        mp_raise_ValueError(MP_ERROR_TEXT("text too long"));
+    }
+    uint8_t idx[DIGIT_ATLAS_MAX_TEXT];
+    int32_t w = 0;
+    for (size_t i = 0; i < len; i++) {
+        const digit_atlas_cell_t *cell = digit_atlas_cell(self, text[i]);
+        if (cell == NULL) {
+            mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("'%c' not in atlas"), text[i]);
+        }
+        idx[i] = (uint8_t)(cell - self->cells);
+        w += cell->adv;
+    }
+    if ((int)len == self->text_len && memcmp(idx, self->text, len) == 0) {
+        return mp_const_none;
+    }
+    memcpy(self->text, idx, len);
+    self->text_len = (int)len;
+    self->text_w = w;
+    if (self->obj != NULL) {
+        lv_obj_invalidate(self->obj);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(digit_atlas_set_text_obj, digit_atlas_set_text);
+
+/* info() — chars, bytes of internal RAM used, line_height */
+static mp_obj_t digit_atlas_info(mp_obj_t self_in) {
+    digit_atlas_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t dict = mp_obj_new_dict(3);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_chars), MP_OBJ_NEW_SMALL_INT(self->n_cells));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bytes), mp_obj_new_int_from_uint(self->mem_size));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_line_height), MP_OBJ_NEW_SMALL_INT(self->line_height));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(digit_atlas_info_obj, digit_atlas_info);
+
+/* Only reached once the drawn object is gone or was never attached */
+static mp_obj_t digit_atlas___del__(mp_obj_t self_in) {
+    digit_atlas_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->mem != NULL) {
+        heap_caps_free(self->mem);
+        self->mem = NULL;
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(digit_atlas___del___obj, digit_atlas___del__);
+
+static const mp_rom_map_elem_t digit_atlas_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_attach),   MP_ROM_PTR(&digit_atlas_attach_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_text), MP_ROM_PTR(&digit_atlas_set_text_obj) },
+    { MP_ROM_QSTR(MP_QSTR_info),     MP_ROM_PTR(&digit_atlas_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR___del__),  MP_ROM_PTR(&digit_atlas___del___obj) },
+};
+static MP_DEFINE_CONST_DICT(digit_atlas_locals_dict, digit_atlas_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    digit_atlas_type,
+    MP_QSTR_DigitAtlas,
+    MP_TYPE_FLAG_NONE,
+    make_new, digit_atlas_make_new,
+    locals_dict, &digit_atlas_locals_dict
+);
 
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Module/type registration                                                 */
@@ -534,8 +4038,25 @@ static MP_DEFINE_CONST_FUN_OBJ_2(rgb_panel_framebuffer_obj, rgb_panel_framebuffe
 static const mp_rom_map_elem_t rgb_panel_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_init),        MP_ROM_PTR(&rgb_panel_init_obj) },
     { MP_ROM_QSTR(MP_QSTR_deinit),      MP_ROM_PTR(&rgb_panel_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_attach),      MP_ROM_PTR(&rgb_panel_attach_obj) },
     { MP_ROM_QSTR(MP_QSTR_backlight),   MP_ROM_PTR(&rgb_panel_backlight_obj) },
+    { MP_ROM_QSTR(MP_QSTR_backlight_info), MP_ROM_PTR(&rgb_panel_backlight_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_auto_dim),    MP_ROM_PTR(&rgb_panel_auto_dim_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wake),        MP_ROM_PTR(&rgb_panel_wake_obj) },
     { MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&rgb_panel_framebuffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_snapshot_chunks), MP_ROM_PTR(&rgb_panel_snapshot_chunks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_bounce_info), MP_ROM_PTR(&rgb_panel_bounce_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sync_info),   MP_ROM_PTR(&rgb_panel_sync_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_info), MP_ROM_PTR(&rgb_panel_refresh_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_period), MP_ROM_PTR(&rgb_panel_refresh_period_obj) },
+    { MP_ROM_QSTR(MP_QSTR_boot_times),  MP_ROM_PTR(&rgb_panel_boot_times_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats),       MP_ROM_PTR(&rgb_panel_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset_stats), MP_ROM_PTR(&rgb_panel_reset_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_apply),       MP_ROM_PTR(&rgb_panel_apply_obj) },
+    { MP_ROM_QSTR(MP_QSTR_lock),        MP_ROM_PTR(&rgb_panel_lock_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unlock),      MP_ROM_PTR(&rgb_panel_unlock_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__),   MP_ROM_PTR(&rgb_panel_lock_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__),    MP_ROM_PTR(&rgb_panel___exit___obj) },
 };
 static MP_DEFINE_CONST_DICT(rgb_panel_locals_dict, rgb_panel_locals_dict_table);
 
@@ -550,6 +4071,40 @@ static MP_DEFINE_CONST_OBJ_TYPE(
 static const mp_rom_map_elem_t rgb_panel_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_rgb_panel_lvgl) },
     { MP_ROM_QSTR(MP_QSTR_RGBPanel), MP_ROM_PTR(&rgb_panel_type) },
+    { MP_ROM_QSTR(MP_QSTR_DigitAtlas), MP_ROM_PTR(&digit_atlas_type) },
+    { MP_ROM_QSTR(MP_QSTR_RENDER_DIRECT),  MP_ROM_INT(RGB_PANEL_RENDER_DIRECT) },
+    { MP_ROM_QSTR(MP_QSTR_RENDER_PARTIAL), MP_ROM_INT(RGB_PANEL_RENDER_PARTIAL) },
+    { MP_ROM_QSTR(MP_QSTR_SPI_BITBANG),    MP_ROM_INT(RGB_PANEL_SPI_BITBANG) },
+    { MP_ROM_QSTR(MP_QSTR_SPI_HW),         MP_ROM_INT(RGB_PANEL_SPI_HW) },
+    { MP_ROM_QSTR(MP_QSTR_SNAPSHOT_RAW),   MP_ROM_INT(RGB_PANEL_SNAPSHOT_RAW) },
+    { MP_ROM_QSTR(MP_QSTR_SNAPSHOT_RLE),   MP_ROM_INT(RGB_PANEL_SNAPSHOT_RLE) },
+    { MP_ROM_QSTR(MP_QSTR_SNAPSHOT_DELTA), MP_ROM_INT(RGB_PANEL_SNAPSHOT_DELTA) },
+    { MP_ROM_QSTR(MP_QSTR_PROP_TEXT),       MP_ROM_INT(RGB_PANEL_PROP_TEXT) },
+    { MP_ROM_QSTR(MP_QSTR_PROP_TEXT_COLOR), MP_ROM_INT(RGB_PANEL_PROP_TEXT_COLOR) },
+    { MP_ROM_QSTR(MP_QSTR_PROP_BG_COLOR),   MP_ROM_INT(RGB_PANEL_PROP_BG_COLOR) },
+    { MP_ROM_QSTR(MP_QSTR_PROP_BG_OPA),     MP_ROM_INT(RGB_PANEL_PROP_BG_OPA) },
+    { MP_ROM_QSTR(MP_QSTR_PROP_HIDDEN),     MP_ROM_INT(RGB_PANEL_PROP_HIDDEN) },
+    { MP_ROM_QSTR(MP_QSTR_pool_info),      MP_ROM_PTR(&rgb_panel_pool_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cached_font),    MP_ROM_PTR(&rgb_panel_cached_font_obj) },
+    { MP_ROM_QSTR(MP_QSTR_blend_info),     MP_ROM_PTR(&rgb_panel_blend_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_blend_bench),    MP_ROM_PTR(&rgb_panel_blend_bench_obj) },
+    { MP_ROM_QSTR(MP_QSTR_trace_start),    MP_ROM_PTR(&rgb_panel_trace_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_trace_stop),     MP_ROM_PTR(&rgb_panel_trace_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_trace),          MP_ROM_PTR(&rgb_panel_trace_emit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_trace_read),     MP_ROM_PTR(&rgb_panel_trace_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_REFR_START),  MP_ROM_INT(RGB_PANEL_TRACE_REFR_START) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_FLUSH_BEGIN), MP_ROM_INT(RGB_PANEL_TRACE_FLUSH_BEGIN) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_FLUSH_END),   MP_ROM_INT(RGB_PANEL_TRACE_FLUSH_END) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_SWAP_QUEUED), MP_ROM_INT(RGB_PANEL_TRACE_SWAP_QUEUED) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_SWAP),        MP_ROM_INT(RGB_PANEL_TRACE_SWAP) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_TIMER_BEGIN), MP_ROM_INT(RGB_PANEL_TRACE_TIMER_BEGIN) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_TIMER_END),   MP_ROM_INT(RGB_PANEL_TRACE_TIMER_END) },
+    { MP_ROM_QSTR(MP_QSTR_TRACE_USER),        MP_ROM_INT(RGB_PANEL_TRACE_USER) },
+    { MP_ROM_QSTR(MP_QSTR_DRAW_UNITS),        MP_ROM_INT(LV_DRAW_SW_DRAW_UNIT_CNT) },
+    #if RGB_PANEL_SIM
+    { MP_ROM_QSTR(MP_QSTR_sim_advance),       MP_ROM_PTR(&rgb_panel_sim_advance_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sim_info),          MP_ROM_PTR(&rgb_panel_sim_info_obj) },
+    #endif
 };
 static MP_DEFINE_CONST_DICT(rgb_panel_module_globals, rgb_panel_module_globals_table);
 
@@ -0,0 +1,328 @@
+/*
+ * Memory-backed RGB panel and ESP-IDF stand-ins for the host build of
+ * rgb_panel_lvgl (see rgb_panel_sim.h).  Only compiled for the unix port
+ * (micropython.mk); the firmware build never sees this file.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rgb_panel_sim.h"
+
+rgb_panel_sim_counts_t rgb_panel_sim_counts;
+
+/* ── Clocks ─────────────────────────────────────────────────────────────── */
+
+static uint64_t rgb_panel_sim_now_us;  /* virtual clock, moved by rgb_panel_sim_advance() */
+
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint32_t rgb_panel_sim_tick_ms(void) {
+    return (uint32_t)(rgb_panel_sim_now_us / 1000);
+}
+
+void rgb_panel_sim_advance(uint64_t us) {
+    rgb_panel_sim_now_us += us;
+}
+
+/* ── FreeRTOS ───────────────────────────────────────────────────────────── */
+
+struct rgb_panel_sim_sem {
+    uint32_t count;
+    uint32_t max;
+};
+
+static SemaphoreHandle_t rgb_panel_sim_sem_new(uint32_t count, uint32_t max) {
+    SemaphoreHandle_t sem = malloc(sizeof(*sem));
+    if (sem != NULL) {
+        sem->count = count;
+        sem->max = max;
+    }
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return rgb_panel_sim_sem_new(0, 1);
+}
+
+/* One thread: a recursive mutex is always available */
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) {
+    return rgb_panel_sim_sem_new(UINT32_MAX, UINT32_MAX);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+    free(sem);
+}
+
+/* Nothing else can give it while we wait: let the panel scan out a frame */
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    if (sem->count == 0 && ticks != 0) {
+        rgb_panel_sim_vsync();
+    }
+    if (sem->count == 0) {
+        return pdFALSE;
+    }
+    if (sem->max != UINT32_MAX) {
+        sem->count--;
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    if (sem->count >= sem->max) {
+        return pdFALSE;
+    }
+    sem->count++;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken) {
+    if (woken != NULL) {
+        *woken = pdFALSE;
+    }
+    return xSemaphoreGive(sem);
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name, uint32_t stack,
+                                   void *arg, int prio, TaskHandle_t *out, int core) {
+    (void)name;
+    (void)stack;
+    (void)prio;
+    (void)core;
+    if (out != NULL) {
+        *out = NULL;
+    }
+    fn(arg);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    (void)task;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    usleep((useconds_t)ticks * 1000);
+}
+
+/* ── Heap ───────────────────────────────────────────────────────────────── */
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    (void)caps;
+    return calloc(n, size);
+}
+
+void *heap_caps_realloc(void *p, size_t size, uint32_t caps) {
+    (void)caps;
+    return realloc(p, size);
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    (void)caps;
+    void *p = NULL;
+    if (alignment < sizeof(void *)) {
+        alignment = sizeof(void *);
+    }
+    return posix_memalign(&p, alignment, size) == 0 ? p : NULL;
+}
+
+void *heap_caps_malloc_prefer(size_t size, size_t num, ...) {
+    (void)num;
+    return malloc(size);
+}
+
+void heap_caps_free(void *p) {
+    free(p);
+}
+
+/* ── LEDC ───────────────────────────────────────────────────────────────── */
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *conf) {
+    return conf->freq_hz > 0 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *conf) {
+    rgb_panel_sim_counts.backlight_duty = conf->duty;
+    return ESP_OK;
+}
+
+esp_err_t ledc_fade_func_install(int intr_alloc_flags) {
+    (void)intr_alloc_flags;
+    return ESP_OK;
+}
+
+esp_err_t ledc_set_duty_and_update(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty, uint32_t hpoint) {
+    (void)mode;
+    (void)channel;
+    (void)hpoint;
+    rgb_panel_sim_counts.backlight_duty = duty;
+    return ESP_OK;
+}
+
+esp_err_t ledc_set_fade_time_and_start(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty,
+                                       uint32_t ms, ledc_fade_mode_t fade_mode) {
+    (void)ms;
+    (void)fade_mode;
+    return ledc_set_duty_and_update(mode, channel, duty, 0);
+}
+
+esp_err_t ledc_stop(ledc_mode_t mode, ledc_channel_t channel, uint32_t idle_level) {
+    (void)mode;
+    (void)channel;
+    (void)idle_level;
+    rgb_panel_sim_counts.backlight_duty = 0;
+    return ESP_OK;
+}
+
+/* ── Panel ──────────────────────────────────────────────────────────────── */
+
+struct rgb_panel_sim_panel {
+    uint32_t width;
+    uint32_t height;
+    uint32_t num_fbs;
+    uint16_t *fb[2];
+    const uint16_t *scanout;        /* buffer being "displayed" */
+    const uint16_t *queued;         /* latched at the next VSYNC */
+    bool off;                       /* scan-out stopped: no VSYNC */
+    esp_lcd_rgb_panel_event_callbacks_t cbs;
+    void *user_ctx;
+    struct rgb_panel_sim_panel *next;
+};
+
+static struct rgb_panel_sim_panel *rgb_panel_sim_panels;
+
+esp_err_t esp_lcd_new_rgb_panel(const esp_lcd_rgb_panel_config_t *config, esp_lcd_panel_handle_t *out) {
+    if (config->num_fbs < 1 || config->num_fbs > 2 || config->bits_per_pixel != 16) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    struct rgb_panel_sim_panel *panel = calloc(1, sizeof(*panel));
+    if (panel == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    panel->width = config->timings.h_res;
+    panel->height = config->timings.v_res;
+    panel->num_fbs = (uint32_t)config->num_fbs;
+    size_t bytes = (size_t)panel->width * panel->height * sizeof(uint16_t);
+    for (uint32_t i = 0; i < panel->num_fbs; i++) {
+        panel->fb[i] = heap_caps_aligned_alloc(64, bytes, MALLOC_CAP_SPIRAM);
+        if (panel->fb[i] == NULL) {
+            free(panel->fb[0]);
+            free(panel);
+            return ESP_ERR_NO_MEM;
+        }
+        memset(panel->fb[i], 0, bytes);
+    }
+    panel->scanout = panel->fb[0];
+    panel->next = rgb_panel_sim_panels;
+    rgb_panel_sim_panels = panel;
+    *out = panel;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_rgb_panel_register_event_callbacks(esp_lcd_panel_handle_t panel,
+                                                     const esp_lcd_rgb_panel_event_callbacks_t *cbs,
+                                                     void *user_ctx) {
+    panel->cbs = *cbs;
+    panel->user_ctx = user_ctx;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_rgb_panel_get_frame_buffer(esp_lcd_panel_handle_t panel, uint32_t fb_num, void **fb0, ...) {
+    if (fb_num < 1 || fb_num > panel->num_fbs) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *fb0 = panel->fb[0];
+    if (fb_num == 2) {
+        va_list ap;
+        va_start(ap, fb0);
+        void **fb1 = va_arg(ap, void **);
+        *fb1 = panel->fb[1];
+        va_end(ap);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_reset(esp_lcd_panel_handle_t panel) {
+    (void)panel;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_init(esp_lcd_panel_handle_t panel) {
+    (void)panel;
+    return ESP_OK;
+}
+
+/* Without a DISP GPIO, esp_lcd stops the LCD peripheral: no frames at all */
+esp_err_t esp_lcd_panel_disp_on_off(esp_lcd_panel_handle_t panel, bool on) {
+    panel->off = !on;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_del(esp_lcd_panel_handle_t panel) {
+    for (struct rgb_panel_sim_panel **p = &rgb_panel_sim_panels; *p != NULL; p = &(*p)->next) {
+        if (*p == panel) {
+            *p = panel->next;
+            break;
+        }
+    }
+    free(panel->fb[0]);
+    free(panel->fb[1]);
+    free(panel);
+    return ESP_OK;
+}
+
+/*
+ * As esp_lcd does: one of the panel's own framebuffers is queued for
+ * scan-out from the next VSYNC, anything else is copied into the (first)
+ * framebuffer.  x_end / y_end are exclusive.
+ */
+esp_err_t esp_lcd_panel_draw_bitmap(esp_lcd_panel_handle_t panel, int x_start, int y_start,
+                                    int x_end, int y_end, const void *color_data) {
+    const uint16_t *src = color_data;
+    if (src == panel->fb[0] || src == panel->fb[1]) {
+        panel->queued = src;
+        return ESP_OK;
+    }
+    if (x_start < 0 || y_start < 0 || x_end > (int)panel->width || y_end > (int)panel->height ||
+        x_start >= x_end || y_start >= y_end) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t w = (size_t)(x_end - x_start);
+    for (int y = y_start; y < y_end; y++) {
+        memcpy(panel->fb[0] + (size_t)y * panel->width + x_start, src, w * sizeof(uint16_t));
+        src += w;
+    }
+    rgb_panel_sim_counts.bitmaps++;
+    rgb_panel_sim_counts.bitmap_bytes += w * (size_t)(y_end - y_start) * sizeof(uint16_t);
+    return ESP_OK;
+}
+
+void rgb_panel_sim_vsync(void) {
+    static const esp_lcd_rgb_panel_event_data_t edata = {0};
+    rgb_panel_sim_counts.vsyncs++;
+    for (struct rgb_panel_sim_panel *p = rgb_panel_sim_panels; p != NULL; p = p->next) {
+        if (p->off) {
+            continue;
+        }
+        if (p->queued != NULL) {
+            p->scanout = p->queued;
+            p->queued = NULL;
+            rgb_panel_sim_counts.swaps++;
+        }
+        if (p->cbs.on_vsync != NULL) {
+            p->cbs.on_vsync(p, &edata, p->user_ctx);
+        }
+    }
+}
@@ -0,0 +1,373 @@
+/*
+ * Host build support for rgb_panel_lvgl (MicroPython unix port)
+ *
+ * Stands in for the ESP-IDF and FreeRTOS APIs the driver uses, so
+ * rgb_panel_lvgl.c builds unchanged against a memory-backed panel
+ * (rgb_panel_sim.c).  The panel keeps its framebuffers in ordinary heap
+ * memory, latches a queued buffer whenever the driver waits for a VSYNC and
+ * counts swaps and bitmap copies, which makes pixel and copy volumes per UI
+ * change reproducible without hardware.
+ *
+ * Single-threaded: semaphores are counters, and taking an empty one runs a
+ * simulated VSYNC instead of blocking.  LVGL's tick is a virtual clock moved
+ * only by rgb_panel_sim_advance(); esp_timer_get_time() itself is the real
+ * monotonic clock so the timing statistics stay meaningful.
+ * Not simulated: SPI panel init, bounce buffers, async memcpy (the driver
+ * falls back to CPU copies), the draw buffer pools and the native LVGL task.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef RGB_PANEL_SIM_H
+#define RGB_PANEL_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define RGB_PANEL_SIM 1
+
+/* Hardware the simulated panel does not have */
+#ifndef MICROPY_HW_RGB_PANEL_SPI_INIT
+#define MICROPY_HW_RGB_PANEL_SPI_INIT 0
+#endif
+#ifndef MICROPY_HW_RGB_PANEL_BOUNCE
+#define MICROPY_HW_RGB_PANEL_BOUNCE 0
+#endif
+
+/* ── esp_err / esp_log / esp_attr ───────────────────────────────────────── */
+
+typedef int esp_err_t;
+
+#define ESP_OK                  0
+#define ESP_FAIL                (-1)
+#define ESP_ERR_NO_MEM          0x101
+#define ESP_ERR_INVALID_ARG     0x102
+#define ESP_ERR_INVALID_STATE   0x103
+#define ESP_ERR_NOT_SUPPORTED   0x106
+
+static inline const char *esp_err_to_name(esp_err_t err) {
+    switch (err) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        default: return "ESP_FAIL";
+    }
+}
+
+#define ESP_ERROR_CHECK(x) do {                                             \
+        esp_err_t err_ = (x);                                               \
+        if (err_ != ESP_OK) {                                               \
+            fprintf(stderr, "%s:%d: %s failed: %s\n", __FILE__, __LINE__,   \
+                    #x, esp_err_to_name(err_));                             \
+            abort();                                                        \
+        }                                                                   \
+    } while (0)
+
+#define ESP_LOGI(tag, fmt, ...) fprintf(stderr, "I %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+
+#define IRAM_ATTR
+
+/* ── esp_timer ──────────────────────────────────────────────────────────── */
+
+int64_t esp_timer_get_time(void);
+
+/* ── FreeRTOS ───────────────────────────────────────────────────────────── */
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+typedef struct rgb_panel_sim_sem *SemaphoreHandle_t;
+typedef int portMUX_TYPE;
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdPASS                  pdTRUE
+#define portMAX_DELAY           UINT32_MAX
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))      /* 1 kHz tick */
+#define configMAX_PRIORITIES    25
+#define ESP_TASK_PRIO_MIN       0
+
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define taskENTER_CRITICAL(mux) ((void)(mux))
+#define taskEXIT_CRITICAL(mux)  ((void)(mux))
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken);
+#define xSemaphoreTakeRecursive(sem, ticks) xSemaphoreTake(sem, ticks)
+#define xSemaphoreGiveRecursive(sem)        xSemaphoreGive(sem)
+
+/* Runs fn to completion on the calling thread */
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name, uint32_t stack,
+                                   void *arg, int prio, TaskHandle_t *out, int core);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+
+/* ── Heap ───────────────────────────────────────────────────────────────── */
+
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void *heap_caps_realloc(void *p, size_t size, uint32_t caps);
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps);
+void *heap_caps_malloc_prefer(size_t size, size_t num, ...);
+void heap_caps_free(void *p);
+
+static inline bool esp_ptr_external_ram(const void *p) {
+    (void)p;
+    return false;
+}
+
+/* No TLSF: pool creation fails, so pool_size / sram_pool_size must stay 0 */
+typedef struct rgb_panel_sim_heap *multi_heap_handle_t;
+typedef struct {
+    size_t total_free_bytes;
+    size_t total_allocated_bytes;
+    size_t largest_free_block;
+    size_t minimum_free_bytes;
+    size_t allocated_blocks;
+    size_t free_blocks;
+    size_t total_blocks;
+} multi_heap_info_t;
+
+static inline multi_heap_handle_t multi_heap_register(void *start, size_t size) {
+    (void)start;
+    (void)size;
+    return NULL;
+}
+static inline void multi_heap_set_lock(multi_heap_handle_t heap, void *lock) {
+    (void)heap;
+    (void)lock;
+}
+static inline void *multi_heap_aligned_alloc(multi_heap_handle_t heap, size_t size, size_t align) {
+    (void)heap;
+    (void)size;
+    (void)align;
+    return NULL;
+}
+static inline void multi_heap_free(multi_heap_handle_t heap, void *p) {
+    (void)heap;
+    (void)p;
+}
+static inline void multi_heap_get_info(multi_heap_handle_t heap, multi_heap_info_t *info) {
+    (void)heap;
+    *info = (multi_heap_info_t){0};
+}
+
+/* ── Cache and async memcpy (CPU copies only) ───────────────────────────── */
+
+#define ESP_CACHE_MSYNC_FLAG_INVALIDATE (1 << 0)
+#define ESP_CACHE_MSYNC_FLAG_DIR_C2M    (1 << 2)
+
+static inline esp_err_t esp_cache_msync(void *addr, size_t size, int flags) {
+    (void)addr;
+    (void)size;
+    (void)flags;
+    return ESP_OK;
+}
+
+typedef struct rgb_panel_sim_mcp *async_memcpy_handle_t;
+typedef struct {
+    void *data;
+} async_memcpy_event_t;
+typedef bool (*async_memcpy_isr_cb_t)(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *ctx);
+typedef struct {
+    uint32_t backlog;
+    size_t sram_trans_align;
+    size_t psram_trans_align;
+    uint32_t flags;
+} async_memcpy_config_t;
+
+#define ASYNC_MEMCPY_DEFAULT_CONFIG() ((async_memcpy_config_t){ .backlog = 8 })
+
+static inline esp_err_t esp_async_memcpy_install(const async_memcpy_config_t *config,
+                                                 async_memcpy_handle_t *out) {
+    (void)config;
+    *out = NULL;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+static inline esp_err_t esp_async_memcpy_uninstall(async_memcpy_handle_t mcp) {
+    (void)mcp;
+    return ESP_OK;
+}
+static inline esp_err_t esp_async_memcpy(async_memcpy_handle_t mcp, void *dst, void *src, size_t n,
+                                         async_memcpy_isr_cb_t cb, void *ctx) {
+    (void)mcp;
+    (void)dst;
+    (void)src;
+    (void)n;
+    (void)cb;
+    (void)ctx;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+/* ── GPIO and SPI (no pins on the host) ─────────────────────────────────── */
+
+typedef int gpio_num_t;
+typedef enum { GPIO_MODE_OUTPUT = 2 } gpio_mode_t;
+typedef enum { GPIO_PULLUP_DISABLE = 0 } gpio_pullup_t;
+typedef enum { GPIO_PULLDOWN_DISABLE = 0 } gpio_pulldown_t;
+typedef enum { GPIO_INTR_DISABLE = 0 } gpio_int_type_t;
+typedef struct {
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    gpio_pullup_t pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+static inline esp_err_t gpio_config(const gpio_config_t *conf) {
+    (void)conf;
+    return ESP_OK;
+}
+static inline esp_err_t gpio_set_level(gpio_num_t pin, uint32_t level) {
+    (void)pin;
+    (void)level;
+    return ESP_OK;
+}
+
+typedef void *spi_device_handle_t;
+#define SPI2_HOST 1
+
+/* ── LEDC (backlight PWM): the duty is kept, fades complete at once ────── */
+
+typedef int ledc_mode_t;
+typedef int ledc_timer_t;
+typedef int ledc_channel_t;
+typedef int ledc_timer_bit_t;
+typedef int ledc_clk_cfg_t;
+typedef int ledc_fade_mode_t;
+#define LEDC_LOW_SPEED_MODE     0
+#define LEDC_TIMER_3            3
+#define LEDC_CHANNEL_7          7
+#define LEDC_TIMER_10_BIT       10
+#define LEDC_AUTO_CLK           0
+#define LEDC_FADE_NO_WAIT       0
+#define LEDC_INTR_DISABLE       0
+
+typedef struct {
+    ledc_mode_t speed_mode;
+    ledc_timer_bit_t duty_resolution;
+    ledc_timer_t timer_num;
+    uint32_t freq_hz;
+    ledc_clk_cfg_t clk_cfg;
+} ledc_timer_config_t;
+
+typedef struct {
+    int gpio_num;
+    ledc_mode_t speed_mode;
+    ledc_channel_t channel;
+    int intr_type;
+    ledc_timer_t timer_sel;
+    uint32_t duty;
+    int hpoint;
+} ledc_channel_config_t;
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *conf);
+esp_err_t ledc_channel_config(const ledc_channel_config_t *conf);
+esp_err_t ledc_fade_func_install(int intr_alloc_flags);
+esp_err_t ledc_set_duty_and_update(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty, uint32_t hpoint);
+esp_err_t ledc_set_fade_time_and_start(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty,
+                                       uint32_t ms, ledc_fade_mode_t fade_mode);
+esp_err_t ledc_stop(ledc_mode_t mode, ledc_channel_t channel, uint32_t idle_level);
+
+/* ── esp_lcd RGB panel ──────────────────────────────────────────────────── */
+
+typedef struct rgb_panel_sim_panel *esp_lcd_panel_handle_t;
+typedef int lcd_clock_source_t;
+#define LCD_CLK_SRC_DEFAULT 0
+
+typedef struct {
+    uint32_t pclk_hz;
+    uint32_t h_res;
+    uint32_t v_res;
+    uint32_t hsync_pulse_width;
+    uint32_t hsync_back_porch;
+    uint32_t hsync_front_porch;
+    uint32_t vsync_pulse_width;
+    uint32_t vsync_back_porch;
+    uint32_t vsync_front_porch;
+    struct {
+        uint32_t pclk_active_neg : 1;
+        uint32_t hsync_idle_low : 1;
+        uint32_t vsync_idle_low : 1;
+    } flags;
+} esp_lcd_rgb_timing_t;
+
+typedef struct {
+    lcd_clock_source_t clk_src;
+    esp_lcd_rgb_timing_t timings;
+    size_t data_width;
+    size_t bits_per_pixel;
+    size_t num_fbs;
+    size_t bounce_buffer_size_px;
+    size_t sram_trans_align;
+    size_t psram_trans_align;
+    int hsync_gpio_num;
+    int vsync_gpio_num;
+    int de_gpio_num;
+    int pclk_gpio_num;
+    int disp_gpio_num;
+    int data_gpio_nums[16];
+    struct {
+        uint32_t fb_in_psram : 1;
+    } flags;
+} esp_lcd_rgb_panel_config_t;
+
+typedef struct {
+    int reserved;
+} esp_lcd_rgb_panel_event_data_t;
+
+typedef bool (*esp_lcd_rgb_panel_vsync_cb_t)(esp_lcd_panel_handle_t panel,
+                                             const esp_lcd_rgb_panel_event_data_t *edata,
+                                             void *user_ctx);
+typedef struct {
+    esp_lcd_rgb_panel_vsync_cb_t on_vsync;
+    esp_lcd_rgb_panel_vsync_cb_t on_bounce_frame_finish;
+} esp_lcd_rgb_panel_event_callbacks_t;
+
+esp_err_t esp_lcd_new_rgb_panel(const esp_lcd_rgb_panel_config_t *config, esp_lcd_panel_handle_t *out);
+esp_err_t esp_lcd_rgb_panel_register_event_callbacks(esp_lcd_panel_handle_t panel,
+                                                     const esp_lcd_rgb_panel_event_callbacks_t *cbs,
+                                                     void *user_ctx);
+esp_err_t esp_lcd_rgb_panel_get_frame_buffer(esp_lcd_panel_handle_t panel, uint32_t fb_num, void **fb0, ...);
+esp_err_t esp_lcd_panel_reset(esp_lcd_panel_handle_t panel);
+esp_err_t esp_lcd_panel_init(esp_lcd_panel_handle_t panel);
+esp_err_t esp_lcd_panel_del(esp_lcd_panel_handle_t panel);
+esp_err_t esp_lcd_panel_disp_on_off(esp_lcd_panel_handle_t panel, bool on);
+esp_err_t esp_lcd_panel_draw_bitmap(esp_lcd_panel_handle_t panel, int x_start, int y_start,
+                                    int x_end, int y_end, const void *color_data);
+
+/* ── Simulation control ─────────────────────────────────────────────────── */
+
+/* What reached the panel since the first panel was created */
+typedef struct {
+    uint32_t vsyncs;                /* simulated frames */
+    uint32_t swaps;                 /* queued framebuffers latched (DIRECT) */
+    uint32_t bitmaps;               /* draw_bitmap() copies into the framebuffer (PARTIAL) */
+    uint64_t bitmap_bytes;
+    uint32_t backlight_duty;        /* LEDC duty last set */
+} rgb_panel_sim_counts_t;
+extern rgb_panel_sim_counts_t rgb_panel_sim_counts;
+
+/* One VSYNC on every panel that is on: latch queued buffers, run on_vsync */
+void rgb_panel_sim_vsync(void);
+
+/* Virtual clock: LVGL's tick, moved on only by rgb_panel_sim_advance() */
+uint32_t rgb_panel_sim_tick_ms(void);
+void rgb_panel_sim_advance(uint64_t us);
+
+#endif /* RGB_PANEL_SIM_H */
@@ -1,6 +1,9 @@
 # Top-level USER_C_MODULES file that includes:
 #   1. lv_binding_micropython (LVGL bindings)
-#   2. rgb_panel_lvgl (generic RGB panel driver with LVGL integration)
+#   2. rgb_panel_lvgl (generic RGB panel driver with LVGL integration,
+#      plus the LV_DRAW_SW_ASM_CUSTOM blend kernels)
+#   3. ble_scan (native BLE advertisement parsing for ble_bridge.py)
+#   4. ble_notify (native GATT notification forwarding for ble_bridge.py)
 #
 # Usage:
 #   make -C ports/esp32 BOARD_DIR=/path/to/boards/GUITION_4848
@@ -28,5 +31,61 @@ endif()
 
 include(${LV_BINDINGS_DIR}/micropython.cmake)
 
+# Parallel rendering: the board sets RGB_PANEL_LVGL_DRAW_UNITS (default 1).
+# lv_conf.h reads it for LVGL itself, the bindings and the panel driver.
+if(NOT DEFINED RGB_PANEL_LVGL_DRAW_UNITS)
+    set(RGB_PANEL_LVGL_DRAW_UNITS 1)
+endif()
+if(TARGET lvgl_interface)
+    target_compile_definitions(lvgl_interface INTERFACE
+        RGB_PANEL_LVGL_DRAW_UNITS=${RGB_PANEL_LVGL_DRAW_UNITS}
+    )
+endif()
+message(STATUS "rgb_panel_lvgl: ${RGB_PANEL_LVGL_DRAW_UNITS} LVGL draw unit(s)")
+
+# SIMD blend kernels (lv_draw_sw_pie.c) behind LV_DRAW_SW_ASM_CUSTOM: on by
+# default for ESP32-S3, a board can set RGB_PANEL_LVGL_PIE 0 to compare.
+if(NOT DEFINED RGB_PANEL_LVGL_PIE)
+    if(IDF_TARGET STREQUAL "esp32s3")
+        set(RGB_PANEL_LVGL_PIE 1)
+    else()
+        set(RGB_PANEL_LVGL_PIE 0)
+    endif()
+endif()
+if(TARGET lvgl_interface)
+    target_compile_definitions(lvgl_interface INTERFACE
+        RGB_PANEL_LVGL_PIE=${RGB_PANEL_LVGL_PIE}
+    )
+    # LVGL's blender includes lv_draw_sw_pie.h from its own sources
+    target_include_directories(lvgl_interface INTERFACE ${_UM_DIR})
+endif()
+
+# Cache sizes: LV_CACHE_DEF_SIZE and LV_IMAGE_HEADER_CACHE_DEF_CNT come from
+# MICROPY_CACHE_SIZE / MICROPY_IMAGE_HEADER_CACHE_COUNT (lv_conf.h), the glyph
+# cache is the driver's own (rgb_panel_lvgl.c).  Unset keeps LVGL's defaults.
+if(TARGET lvgl_interface)
+    if(DEFINED RGB_PANEL_LVGL_IMAGE_CACHE)
+        target_compile_definitions(lvgl_interface INTERFACE
+            MICROPY_CACHE_SIZE=${RGB_PANEL_LVGL_IMAGE_CACHE}
+        )
+    endif()
+    if(DEFINED RGB_PANEL_LVGL_IMAGE_HEADER_CACHE)
+        target_compile_definitions(lvgl_interface INTERFACE
+            MICROPY_IMAGE_HEADER_CACHE_COUNT=${RGB_PANEL_LVGL_IMAGE_HEADER_CACHE}
+        )
+    endif()
+    if(DEFINED RGB_PANEL_LVGL_GLYPH_CACHE)
+        target_compile_definitions(lvgl_interface INTERFACE
+            RGB_PANEL_GLYPH_CACHE_ENTRIES=${RGB_PANEL_LVGL_GLYPH_CACHE}
+        )
+    endif()
+endif()
+
 # RGB panel driver
 include(${_UM_DIR}/micropython.cmake)
+
+# BLE scan helpers
+include(${_UM_DIR}/../ble_scan/micropython.cmake)
+
+# GATT notification forwarding
+include(${_UM_DIR}/../ble_notify/micropython.cmake)
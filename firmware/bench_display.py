@@ -0,0 +1,261 @@
+"""On-device benchmark for the rgb_panel_lvgl display path.
+
+Runs a fixed set of scenes on a temporary screen and prints one JSON object,
+so results from different builds (rgb_panel_flush_cb, lv_conf.h, sdkconfig
+PSRAM settings) can be compared on the same board:
+
+    import bench_display
+    bench_display.run()             # after ui.init(), from the REPL
+
+Per scene: wall time per forced refresh (frame_us), pixels flushed, time in
+flush_cb, the DIRECT sync copy and its bandwidth (copy_mb_s), and cpu_load,
+the share of the CPU the free-running scene takes from Python.  "kernels"
+times each blend kernel against LVGL's generic loop (generic_us, kernel_us,
+match) over SRAM and PSRAM destinations.
+
+Frozen into the GUITION_4848 firmware; needs the display to be initialised.
+"""
+
+import json
+import time
+
+import board
+
+FRAMES = 60
+LOAD_MS = 1000
+
+# 10% of 480x480
+_DIRTY_SIDE = 152
+_IMAGE_SIDE = 160
+
+
+_TASK = getattr(board, "LVGL_TASK", False)
+
+
+def _lock():
+    # The native LVGL task renders concurrently; the display object is its lock
+    return board.display_dev if _TASK else _NoLock()
+
+
+class _NoLock:
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        return False
+
+
+# ─── Scenes ──────────────────────────────────────────────────────────────────
+# Each scene builds its widgets on scr and returns step(i), which changes
+# something on screen for frame i.
+
+
+def _plain(lv, parent, w, h):
+    o = lv.obj(parent)
+    o.set_size(w, h)
+    o.set_style_border_width(0, 0)
+    o.set_style_radius(0, 0)
+    o.set_style_pad_all(0, 0)
+    o.set_style_bg_opa(lv.OPA.COVER, 0)
+    o.remove_flag(lv.obj.FLAG.SCROLLABLE)
+    return o
+
+
+def _scene_full(lv, scr):
+    o = _plain(lv, scr, board.DISPLAY_WIDTH, board.DISPLAY_HEIGHT)
+    colors = (lv.color_hex(0x1A1F2E), lv.color_hex(0x334155))
+
+    def step(i):
+        o.set_style_bg_color(colors[i & 1], 0)
+    return step
+
+
+def _scene_dirty10(lv, scr):
+    o = _plain(lv, scr, _DIRTY_SIDE, _DIRTY_SIDE)
+    o.center()
+    colors = (lv.color_hex(0x818CF8), lv.color_hex(0x4ADE80))
+
+    def step(i):
+        o.set_style_bg_color(colors[i & 1], 0)
+    return step
+
+
+def _scene_labels(lv, scr):
+    labels = []
+    for n in range(48):
+        lbl = lv.label(scr)
+        lbl.set_style_text_font(lv.font_montserrat_14, 0)
+        lbl.set_pos(10 + (n % 6) * 78, 10 + (n // 6) * 58)
+        labels.append(lbl)
+
+    def step(i):
+        for n, lbl in enumerate(labels):
+            lbl.set_text(str(i * 48 + n))
+    return step
+
+
+def _scene_scroll(lv, scr):
+    lst = lv.list(scr)
+    lst.set_size(board.DISPLAY_WIDTH, board.DISPLAY_HEIGHT)
+    for n in range(40):
+        lst.add_button(None, "Item %d" % n)
+
+    def step(i):
+        lst.scroll_by(0, -8 if (i // 20) & 1 else 8, lv.ANIM.OFF)
+    return step
+
+
+def _scene_image(lv, scr):
+    side = _IMAGE_SIDE
+    px = bytearray(side * side * 2)
+    for y in range(side):
+        row = ((y * 31 // side) << 11 | (y * 63 // side) << 5).to_bytes(2, "little")
+        px[y * side * 2:(y + 1) * side * 2] = row * side
+    dsc = lv.image_dsc_t({
+        "header": {
+            "magic": 0x19,                          # LV_IMAGE_HEADER_MAGIC
+            "cf": lv.COLOR_FORMAT.RGB565,
+            "w": side,
+            "h": side,
+            "stride": side * 2,
+        },
+        "data_size": len(px),
+        "data": px,
+    })
+    img = lv.image(scr)
+    img.set_src(dsc)
+    span_x = board.DISPLAY_WIDTH - side
+    span_y = board.DISPLAY_HEIGHT - side
+
+    def step(i):
+        img.set_pos((i * 7) % span_x, (i * 5) % span_y)
+    step.keep = (px, dsc)   # the image data must outlive the scene
+    return step
+
+
+SCENES = (
+    ("full", _scene_full),
+    ("dirty10", _scene_dirty10),
+    ("labels", _scene_labels),
+    ("scroll", _scene_scroll),
+    ("image", _scene_image),
+)
+
+
+# ─── Measurement ─────────────────────────────────────────────────────────────
+
+def _spin(ms, lv):
+    """Busy-loop for ms; returns (iterations, us spent inside lv.task_handler)."""
+    n = 0
+    busy = 0
+    t_end = time.ticks_add(time.ticks_ms(), ms)
+    while time.ticks_diff(t_end, time.ticks_ms()) > 0:
+        if not _TASK:
+            t = time.ticks_us()
+            lv.task_handler()
+            busy += time.ticks_diff(time.ticks_us(), t)
+        n += 1
+    return n, busy
+
+
+def _cpu_load(lv, step, idle):
+    """Share of the CPU the scene takes while LVGL animates it freely."""
+    state = {"i": 0}
+
+    def tick(_t):
+        state["i"] += 1
+        step(state["i"])
+
+    with _lock():
+        timer = lv.timer_create(tick, 16, None)
+    n, busy = _spin(LOAD_MS, lv)
+    with _lock():
+        timer.delete()
+    if not _TASK:
+        return round(busy / (LOAD_MS * 1000), 3)
+    return round(max(0.0, 1 - n / idle[0]), 3) if idle[0] else None
+
+
+def _scene_result(disp, frames, wall_us, load):
+    with _lock():
+        w = disp.stats()["window"]
+    copy_us = w.get("copy_us", 0)
+    return {
+        "frame_us": wall_us // frames,
+        "fps": round(frames * 1_000_000 / wall_us, 1) if wall_us else 0,
+        "px_per_frame": w["px"] // frames,
+        "flush_avg_us": w["flush_avg_us"],
+        "copy_us_per_frame": copy_us // frames,
+        "copy_mb_s": round(w["bytes_copied"] / copy_us, 1) if copy_us else None,
+        "cpu_load": load,
+    }
+
+
+def _run_scene(lv, disp, make, frames, idle):
+    with _lock():
+        scr = lv.obj()
+        scr.set_style_bg_color(lv.color_hex(0x0F1119), 0)
+        step = make(lv, scr)
+        prev = lv.screen_active()
+        lv.screen_load(scr)
+        lv.refr_now(None)
+        disp.stats()   # start a fresh window
+
+    t0 = time.ticks_us()
+    for i in range(frames):
+        with _lock():
+            step(i)
+            lv.refr_now(None)
+    wall = time.ticks_diff(time.ticks_us(), t0)
+    res = _scene_result(disp, frames, wall, None)
+    res["cpu_load"] = _cpu_load(lv, step, idle)
+
+    with _lock():
+        lv.screen_load(prev)
+        scr.delete()
+    return res
+
+
+def _kernel_times(r):
+    generic_us, kernel_us, match = r
+    return {"generic_us": generic_us, "kernel_us": kernel_us, "match": match}
+
+
+def _kernels():
+    import rgb_panel_lvgl as rp
+    if not hasattr(rp, "blend_bench"):
+        return None
+    sram = rp.blend_bench(480, 40, 10, psram=False)
+    psram = rp.blend_bench(480, 40, 10, psram=True)
+    return {k: {"sram": _kernel_times(sram[k]), "psram": _kernel_times(psram[k])} for k in sram}
+
+
+def run(frames=FRAMES, scenes=None):
+    """Run the scenes (all, or the names given) and print the JSON result."""
+    import gc
+    import lvgl as lv
+    import rgb_panel_lvgl as rp
+
+    disp = getattr(board, "display_dev", None)
+    if disp is None:
+        raise RuntimeError("display not initialised")
+
+    gc.collect()
+    idle = _spin(LOAD_MS, lv)   # baseline Python loop rate with a static screen
+    result = {
+        "board": board.BOARD_NAME,
+        "frames": frames,
+        "draw_units": getattr(rp, "DRAW_UNITS", 1),
+        "pie": rp.blend_info()["hooks"] if hasattr(rp, "blend_info") else False,
+        "lvgl_task": _TASK,
+        "scenes": {},
+    }
+    for name, make in SCENES:
+        if scenes is not None and name not in scenes:
+            continue
+        gc.collect()
+        result["scenes"][name] = _run_scene(lv, disp, make, frames, idle)
+    result["kernels"] = _kernels()
+
+    print(json.dumps(result))
+    return result
@@ -8,6 +8,23 @@ import aioble
 import asyncio
 import bluetooth
 import board
+import trace
+
+try:
+    import ble_scan  # native parser, only in firmware built with drivers/ble_scan
+except ImportError:
+    ble_scan = None
+
+try:
+    import ble_notify  # native notify queue, only in NimBLE firmware built with drivers/ble_notify
+except ImportError:
+    ble_notify = None
+
+# The scan ring needs a NimBLE build; parse()/merge() work everywhere
+_native_ring = ble_scan is not None and hasattr(ble_scan, "start")
+
+# scan/results encodings this firmware can produce, announced on "capabilities"
+SCAN_FORMATS = ("json", "packed") if _native_ring and hasattr(ble_scan, "results_packed") else ("json",)
 
 _ble = bluetooth.BLE()
 
@@ -73,6 +90,18 @@ def _parse_raw_entry(addr_bytes, addr_type, rssi, raw):
     return entry
 
 
+def _merge_raw(seen, addr_bytes, addr_type, rssi, raw):
+    """Parse and merge one raw advertisement into seen.
+
+    The native module keys seen by the address bytes and updates entries in
+    place; the Python fallback keys by MAC string.
+    """
+    if ble_scan:
+        ble_scan.merge(seen, addr_bytes, addr_type, rssi, raw)
+    else:
+        _merge_entry(seen, _parse_raw_entry(addr_bytes, addr_type, rssi, raw))
+
+
 def _merge_entry(seen, entry):
     """Merge a parsed device entry into the seen dict (dedup by MAC, strongest RSSI)."""
     mac = entry["address"]
@@ -93,6 +122,8 @@ class BleBridge:
         self._conn = None
         self._chars = {}  # uuid_str -> characteristic
         self._notify_tasks = []
+        self._notify_subs = {}  # ble_notify id -> (uuid_str, publish_fn)
+        self._notify_flag = None
         self._on_disconnect = None
         self._disconnect_fired = False
         # Streaming scan state
@@ -101,6 +132,7 @@ class BleBridge:
         self._seen = {}
         self._seen_cycle = 0
         self._cap_logged = False
+        self._dropped = 0
 
     def set_on_disconnect(self, callback):
         """Set callback for unexpected peripheral disconnect (fires at most once)."""
@@ -144,8 +176,7 @@ class BleBridge:
                 pass
 
             for addr_bytes, addr_type, rssi, raw in raw_results:
-                entry = _parse_raw_entry(addr_bytes, addr_type, rssi, raw)
-                _merge_entry(seen, entry)
+                _merge_raw(seen, addr_bytes, addr_type, rssi, raw)
 
             results = [v for v in seen.values() if v["name"] or v.get("manufacturer_data")]
             seen.clear()
@@ -163,7 +194,9 @@ class BleBridge:
         """Start an indefinite BLE scan (ESP32-S3 continuous mode).
 
         IRQ handler accumulates raw results; call drain_results() periodically
-        to process and publish them.
+        to process and publish them. With the native ble_scan module, results
+        go into its preallocated ring and device table instead and nothing is
+        allocated per advertisement.
         """
         import gc
         gc.collect()
@@ -172,6 +205,14 @@ class BleBridge:
         self._seen = {}
         self._seen_cycle = 0
         self._cap_logged = False
+        self._dropped = 0
+
+        if _native_ring:
+            _ble.active(True)
+            ble_scan.table(board.MAX_SCAN_ENTRIES, board.SEEN_TTL_MS)
+            ble_scan.start(board.MAX_SCAN_ENTRIES, 100000, 30000, True)
+            print("Streaming scan started (native ring)")
+            return
 
         def _irq(event, data):
             if event == 5:  # _IRQ_SCAN_RESULT
@@ -191,16 +232,21 @@ class BleBridge:
         """Drain accumulated raw scan results and return filtered device list.
 
         Merges into _seen dict for cross-cycle dedup. Clears _seen every
-        SEEN_RESET_CYCLES drains to age out disappeared devices.
+        SEEN_RESET_CYCLES drains to age out disappeared devices. The native
+        device table instead evicts each device SEEN_TTL_MS after it was
+        last heard.
         """
+        if _native_ring:
+            self._drain_ring()
+            return ble_scan.results()
+
         # Atomically swap raw_results (IRQ appends are non-preemptive)
         raw = self._raw_results
         self._raw_results = []
         self._cap_logged = False
 
         for addr_bytes, addr_type, rssi, adv_raw in raw:
-            entry = _parse_raw_entry(addr_bytes, addr_type, rssi, adv_raw)
-            _merge_entry(self._seen, entry)
+            _merge_raw(self._seen, addr_bytes, addr_type, rssi, adv_raw)
 
         self._seen_cycle += 1
         if self._seen_cycle >= board.SEEN_RESET_CYCLES:
@@ -211,11 +257,54 @@ class BleBridge:
 
         return [v for v in self._seen.values() if v["name"] or v.get("manufacturer_data")]
 
+    def set_filter(self, macs=(), services=(), manufacturers=(), discover_ms=0, window_ms=0):
+        """Only pass scan results from listed MACs, service UUIDs or company IDs.
+
+        Applied in the native scan callback, so rejected advertisements never
+        reach the ring or the heap. Everything passes for window_ms out of
+        every discover_ms so unknown devices still show up. With no lists the
+        filter is off. No-op without the native ble_scan module.
+        """
+        if not _native_ring:
+            return
+        if not (macs or services or manufacturers):
+            ble_scan.filter()
+            return
+        ble_scan.filter(
+            macs=list(macs),
+            services=list(services),
+            manufacturers=list(manufacturers),
+            discover_every_ms=discover_ms,
+            discover_window_ms=window_ms,
+        )
+
+    def _drain_ring(self):
+        ble_scan.drain()
+        dropped = ble_scan.info()["dropped"]
+        if dropped != self._dropped:
+            print(f"Scan ring full, {dropped - self._dropped} results dropped since last drain")
+            self._dropped = dropped
+
+    def drain_packed(self):
+        """Like drain_results(), but return the device list in the packed
+        scan/results encoding, built in C without any per-device objects.
+        Only when "packed" is in SCAN_FORMATS.
+        """
+        self._drain_ring()
+        return ble_scan.results_packed()
+
+    def seen(self, address):
+        """Whether the native device table currently holds address."""
+        return ble_scan.seen(address)
+
     def stop_streaming(self):
         """Stop the indefinite BLE scan."""
         if self._streaming:
             try:
-                _ble.gap_scan(None)
+                if _native_ring:
+                    ble_scan.stop()
+                else:
+                    _ble.gap_scan(None)
             except Exception:
                 pass
             self._streaming = False
@@ -263,11 +352,25 @@ class BleBridge:
         return {"chars": chars_info}
 
     async def start_notify(self, uuid_str, publish_fn):
-        """Start forwarding notifications from a characteristic via publish_fn."""
+        """Start forwarding notifications from a characteristic via publish_fn.
+
+        With the native ble_notify module, notifications are queued in C as
+        they arrive and one task drains and publishes them in batches.
+        """
         char = self._chars.get(uuid_str)
         if not char:
             return
 
+        if ble_notify is not None:
+            if self._notify_flag is None:
+                self._notify_flag = asyncio.ThreadSafeFlag()
+                flag = self._notify_flag
+                ble_notify.start(lambda _: flag.set())
+                self._notify_tasks.append(asyncio.create_task(self._native_notify_loop()))
+            sub = ble_notify.subscribe(self._conn._conn_handle, char._value_handle)
+            self._notify_subs[sub] = (uuid_str, publish_fn)
+            return
+
         async def _notify_loop():
             try:
                 while self._conn and self._conn.is_connected():
@@ -278,15 +381,38 @@ class BleBridge:
                 pass
             except Exception as e:
                 print(f"Notify loop error ({uuid_str}): {e}")
-            # Fire disconnect callback once if connection was lost (not cancelled)
-            if not self._disconnect_fired and self._conn and not self._conn.is_connected():
-                self._disconnect_fired = True
-                if self._on_disconnect:
-                    self._on_disconnect()
+            self._check_connection_lost()
 
         task = asyncio.create_task(_notify_loop())
         self._notify_tasks.append(task)
 
+    async def _native_notify_loop(self):
+        """Publish everything ble_notify queued, each time it signals."""
+        try:
+            while self._conn and self._conn.is_connected():
+                try:
+                    await asyncio.wait_for_ms(self._notify_flag.wait(), 10000)
+                except asyncio.TimeoutError:
+                    continue  # re-check the connection
+                for sub, t_us, data in ble_notify.drain():
+                    trace.emit(trace.NOTIFY_RX, sub, t_us)
+                    target = self._notify_subs.get(sub)
+                    if target:
+                        await target[1](target[0], data)
+                        trace.emit(trace.NOTIFY_PUBLISH, len(data))
+        except asyncio.CancelledError:
+            pass
+        except Exception as e:
+            print(f"Notify loop error: {e}")
+        self._check_connection_lost()
+
+    def _check_connection_lost(self):
+        # Fire disconnect callback once if connection was lost (not cancelled)
+        if not self._disconnect_fired and self._conn and not self._conn.is_connected():
+            self._disconnect_fired = True
+            if self._on_disconnect:
+                self._on_disconnect()
+
     async def write(self, uuid_str, data):
         """Write data to a characteristic (auto-detects response mode)."""
         char = self._chars.get(uuid_str)
@@ -307,6 +433,15 @@ class BleBridge:
         for task in self._notify_tasks:
             task.cancel()
         self._notify_tasks.clear()
+        if self._notify_flag is not None:
+            info = ble_notify.info()
+            print(
+                f"Notify: {info['drained']} forwarded, {info['dropped']} dropped, "
+                f"queue latency avg {info['latency_avg_us']} us / max {info['latency_max_us']} us"
+            )
+            ble_notify.stop()
+            self._notify_flag = None
+        self._notify_subs = {}
 
         if self._conn:
             try:
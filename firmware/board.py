@@ -1,11 +1,13 @@
 """Board auto-detection and dispatch.
 
 Reads optional "board" override from config.json, otherwise detects the
-chip family from os.uname().machine.  Re-exports all constants from the
+chip family from os.uname().machine.  The unix port (sys.platform linux or
+darwin) gets the simulated display board.  Re-exports all constants from the
 matched board module so callers just `import board`.
 """
 
 import os
+import sys
 import json
 
 # Check config.json for explicit board override
@@ -16,9 +18,12 @@ except Exception:
     _override = None
 
 # Auto-detect from chip identifier
-_machine = os.uname().machine.upper()
+_host = sys.platform in ("linux", "darwin")
+_machine = "" if _host else os.uname().machine.upper()
 
-if _override == "atom_echo" or (
+if _override == "host" or (not _override and _host):
+    from board_host import *
+elif _override == "atom_echo" or (
     not _override and "ESP32S3" not in _machine and "ESP32-S3" not in _machine
 ):
     from board_atom_echo import *
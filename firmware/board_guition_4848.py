@@ -2,7 +2,8 @@
 
 ST7701S RGB LCD with 480x480 resolution.  Uses lv_binding_micropython +
 rgb_panel_lvgl C module for hardware init (RGB bus, SPI 3-wire, backlight).
-Panel init sequence is data-driven from panel_init_guition_4848.py.
+Panel init sequence is data-driven from panel_init_guition_4848.py, sent as
+the packed blob in panel_init_guition_4848_blob.py.
 
 Pin mapping from https://homeding.github.io/boards/esp32s3/panel-4848S040.htm
 """
@@ -14,6 +15,7 @@ DEACTIVATE_BLE_AFTER_SCAN = False
 CONTINUOUS_SCAN = True
 PUBLISH_INTERVAL_MS = 2000   # drain+publish every 2s
 SEEN_RESET_CYCLES = 5        # clear _seen every 5 drains (10s) to age out gone devices
+SEEN_TTL_MS = 10000          # native ble_scan table: evict devices silent for 10s
 
 # Scan timing (batch mode fallback)
 SCAN_INTERVAL_MS = 2000
@@ -35,9 +37,21 @@ display_dev = None
 
 # Display
 HAS_DISPLAY = True
+LVGL_TASK = True             # C driver renders from its own task; ui.py takes its lock
 DISPLAY_WIDTH = 480
 DISPLAY_HEIGHT = 480
 
+# LVGL refresh period (ms), switched by ui.py: smooth while a scale is
+# detected or a reading is shown, coalesced to 5 fps for the idle / result
+# screens, where only the status indicators change.  Nothing is rendered at
+# all while nothing is invalidated.
+REFRESH_ACTIVE_MS = 33
+REFRESH_IDLE_MS = 200
+
+# Fade the backlight out and stop scan-out after 10 minutes without a scale
+# in range; ui.py wakes the display on every state change.  0 disables.
+AUTO_DIM_MS = 10 * 60_000
+
 # ─── Pin mapping ─────────────────────────────────────────────────────────────
 
 # 16-bit RGB565 data bus: Blue(0-4), Green(5-10), Red(11-15)
@@ -54,25 +68,48 @@ _SPI_SCL = 48
 _SPI_SDA = 47
 _SPI_CS = 39
 
-# Backlight
+# Backlight, PWM-dimmed through LEDC
 _BACKLIGHT_PIN = 38
+_BACKLIGHT_FREQ = 5000
+_AUTO_DIM_FADE_MS = 1500
+
+# Scan out through 2x10-line internal SRAM bounce buffers (~19 KB) instead of
+# letting the LCD DMA read PSRAM directly, which glitches under WiFi/BLE load.
+# 0 disables.  480 must divide evenly by 2 * lines.
+_BOUNCE_BUFFER_LINES = 10
+
+# Keep the two framebuffers in sync with the GDMA async memcpy engine instead
+# of a CPU memcpy in the flush callback.
+_ASYNC_COPY = True
+
+# LVGL pixel buffers (layers, decoded images, glyphs) come from TLSF pools
+# outside the MicroPython heap, so gc.collect() does not scan them.  The SRAM
+# pool holds one 24 KB layer chunk; larger buffers go to PSRAM.  0 disables.
+_LVGL_POOL = 512 * 1024
+_LVGL_SRAM_POOL = 28 * 1024
 
 
 def init_display():
     """Initialise ST7701S panel and register LVGL display driver.
 
     Uses the rgb_panel_lvgl C module which handles:
-    - SPI 3-wire bit-bang init (Mode 3 equivalent, ~500kHz)
+    - SPI 3-wire init on the SPI2 peripheral (Mode 3, 4 MHz, bit-bang fallback)
     - RGB bus setup via esp_lcd_panel_rgb (16-bit, 12MHz pixel clock)
-    - Data-driven panel init sequence from panel_init_guition_4848
+    - Bounce-buffer scan-out from internal SRAM (see _BOUNCE_BUFFER_LINES)
+    - DMA framebuffer sync copy (see _ASYNC_COPY)
+    - Data-driven panel init sequence, pre-packed into a frozen bytes blob
     - LVGL display creation with double-buffered DIRECT mode
-    - LVGL tick via esp_timer (no Python tick_inc needed)
+    - LVGL tick read from esp_timer (no Python tick_inc, no timer interrupt)
+    - lv_timer_handler() in a native task when LVGL_TASK is set
+
+    After a soft reset the panel is still running from the last boot:
+    attach() takes it over and skips the init sequence and panel setup.
     """
     global display_dev
     try:
         import lvgl as lv
-        from rgb_panel_lvgl import RGBPanel
-        from panel_init_guition_4848 import INIT_CMDS
+        from rgb_panel_lvgl import RGBPanel, SPI_HW
+        from panel_init_guition_4848_blob import INIT_BLOB
 
         lv.init()
 
@@ -94,10 +131,21 @@ def init_display():
             spi_scl=_SPI_SCL,
             spi_sda=_SPI_SDA,
             spi_cs=_SPI_CS,
+            spi_backend=SPI_HW,
             backlight=_BACKLIGHT_PIN,
-            init_cmds=INIT_CMDS,
+            backlight_freq=_BACKLIGHT_FREQ,
+            init_cmds=INIT_BLOB,
+            bounce_buffer_lines=_BOUNCE_BUFFER_LINES,
+            async_copy=_ASYNC_COPY,
+            lvgl_task=LVGL_TASK,
+            pool_size=_LVGL_POOL,
+            sram_pool_size=_LVGL_SRAM_POOL,
+            boot_log=True,
         )
-        display.init()
+        if not display.attach():
+            display.init()
+        if AUTO_DIM_MS:
+            display.auto_dim(AUTO_DIM_MS, 0, _AUTO_DIM_FADE_MS)
         display_dev = display
 
         print("LVGL display ready (rgb_panel_lvgl driver)")
@@ -0,0 +1,77 @@
+"""Board config: host MicroPython (unix port) with the simulated RGB panel.
+
+Built by drivers/build.sh unix.  rgb_panel_lvgl renders into framebuffers
+in ordinary memory (drivers/rgb_panel_lvgl/rgb_panel_sim.c) with the same
+flush and double-buffer sync paths as the Guition board, so ui.py runs
+unchanged and its pixel / copy counts can be compared without hardware
+(firmware/tools/replay_ui.py).  There is no BLE or WiFi: main.py does not
+run here.
+"""
+
+BOARD_NAME = "host"
+
+DEACTIVATE_BLE_AFTER_SCAN = False
+CONTINUOUS_SCAN = False
+SCAN_INTERVAL_MS = 2000
+SCAN_DURATION_MS = 8000
+MAX_SCAN_ENTRIES = 500
+AGGRESSIVE_GC = False
+GC_INTERVAL = 1000
+
+HAS_BEEP = False
+BEEP_PINS = None
+
+# Display object (set by init_display)
+display_dev = None
+
+# Display: same geometry as the Guition 4848.  No native LVGL task on the host;
+# the caller runs lv.task_handler() / lv.refr_now() itself.
+HAS_DISPLAY = True
+LVGL_TASK = False
+DISPLAY_WIDTH = 480
+DISPLAY_HEIGHT = 480
+
+# RENDER_DIRECT (two framebuffers, sync copy) like the Guition board, or
+# RENDER_PARTIAL; replay_ui.py --partial switches it.
+RENDER_MODE = 0
+DRAW_BUF_LINES = 40
+
+
+def init_display():
+    """Register the simulated panel as the LVGL display.
+
+    The pin and timing arguments are required by RGBPanel but unused; SPI
+    init, bounce buffers, async copy and the pixel-buffer pools are not
+    simulated and stay off.
+    """
+    global display_dev
+    try:
+        import lvgl as lv
+        from rgb_panel_lvgl import RGBPanel
+
+        lv.init()
+
+        display = RGBPanel(
+            width=DISPLAY_WIDTH,
+            height=DISPLAY_HEIGHT,
+            data_pins=list(range(16)),
+            hsync_pin=16,
+            vsync_pin=17,
+            de_pin=18,
+            pclk_pin=21,
+            render_mode=RENDER_MODE,
+            draw_buf_lines=DRAW_BUF_LINES,
+        )
+        display.init()
+        display_dev = display
+        return display
+    except Exception as e:
+        print(f"Display init failed: {e}")
+        import sys
+        sys.print_exception(e)
+        return None
+
+
+def on_scan_complete(results, scale_found):
+    """No-op — display updates are handled by ui.py state machine."""
+    pass
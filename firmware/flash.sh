@@ -198,9 +198,11 @@ upload_app() {
   mpremote connect "$port" cp board.py :board.py
   mpremote connect "$port" cp "$BOARD_MODULE" ":$BOARD_MODULE"
   mpremote connect "$port" cp ble_bridge.py :ble_bridge.py
+  mpremote connect "$port" cp trace.py :trace.py
   mpremote connect "$port" cp beep.py :beep.py
   if [[ "$BOARD" == "guition_4848" ]]; then
     mpremote connect "$port" cp panel_init_guition_4848.py :panel_init_guition_4848.py
+    mpremote connect "$port" cp panel_init_guition_4848_blob.py :panel_init_guition_4848_blob.py
     mpremote connect "$port" cp ui.py :ui.py
   fi
   mpremote connect "$port" cp main.py :main.py
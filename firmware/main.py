@@ -11,7 +11,8 @@ import gc
 import time
 import board
 from mqtt_as import MQTTClient, config as mqtt_config
-from ble_bridge import BleBridge
+from ble_bridge import BleBridge, SCAN_FORMATS
+import trace
 
 if board.HAS_BEEP:
     from beep import beep
@@ -48,6 +49,9 @@ _pending = []
 _scale_macs = set()
 _last_beep_time = 0
 
+# scan/results encoding requested by the server on scan/format
+_scan_format = "json"
+
 
 def topic(suffix):
     return f"{BASE}/{suffix}"
@@ -67,15 +71,38 @@ mqtt_config["clean"] = True
 mqtt_config["queue_len"] = 0  # callback mode
 
 
+def _apply_scan_filter(spec):
+    """Opt-in scan allowlist from the config's "filter" object."""
+    if not spec:
+        bridge.set_filter()
+        return
+    bridge.set_filter(
+        macs=set(spec.get("macs", [])) | _scale_macs,
+        services=spec.get("services", []),
+        manufacturers=spec.get("manufacturers", []),
+        discover_ms=int(spec.get("discover_s", 60) * 1000),
+        window_ms=getattr(board, "PUBLISH_INTERVAL_MS", 2000),
+    )
+    print("Scan filter: on")
+
+
 def on_message(topic_bytes, msg, retained):
     """Sync callback — queue the command for async processing."""
-    global _scale_macs
+    global _scale_macs, _scan_format
     t = topic_bytes.decode() if isinstance(topic_bytes, (bytes, bytearray)) else topic_bytes
+    if t == topic("display/reading"):
+        trace.emit(trace.READING_RX)
+    if t == topic("scan/format"):
+        fmt = msg.decode() if isinstance(msg, (bytes, bytearray)) else msg
+        _scan_format = fmt if fmt in SCAN_FORMATS else "json"
+        print(f"Scan results format: {_scan_format}")
+        return
     if t == topic("config"):
         try:
             data = json.loads(msg)
             _scale_macs = set(data.get("scales", []))
             print(f"Config: {len(_scale_macs)} scale MAC(s)")
+            _apply_scan_filter(data.get("filter"))
             if board.HAS_DISPLAY:
                 ui.on_config_update(data.get("users", []))
                 ui.on_scale_macs_update(len(_scale_macs) > 0)
@@ -93,10 +120,12 @@ async def on_connect(client_ref):
     await client_ref.subscribe(topic("disconnect"), 0)
     await client_ref.subscribe(topic("config"), 0)
     await client_ref.subscribe(topic("beep"), 0)
+    await client_ref.subscribe(topic("scan/format"), 0)
     if board.HAS_DISPLAY:
         await client_ref.subscribe(topic("display/reading"), 0)
         await client_ref.subscribe(topic("display/result"), 0)
         await client_ref.subscribe(topic("screenshot"), 0)
+        await client_ref.subscribe(topic("trace"), 0)
     # Re-subscribe write/read wildcards if a BLE device is connected
     if _char_subscribed:
         await client_ref.subscribe(topic("write/#"), 0)
@@ -104,6 +133,7 @@ async def on_connect(client_ref):
     _subs_ready = True
     if board.HAS_DISPLAY:
         ui.on_mqtt_change(True)
+    await client_ref.publish(topic("capabilities"), json.dumps({"scan_formats": SCAN_FORMATS}), retain=True, qos=1)
     await client_ref.publish(topic("status"), "online", retain=True, qos=1)
     print(f"BLE-MQTT bridge ready: {BASE}")
 
@@ -128,20 +158,78 @@ async def publish_error(message):
     print(f"Error: {message}")
 
 
+async def _publish_display_stats():
+    """Publish RGBPanel render stats (window since the last call + totals)."""
+    if board.display_dev is None:
+        return
+    import rgb_panel_lvgl
+
+    with board.display_dev:
+        stats = board.display_dev.stats()
+        if hasattr(rgb_panel_lvgl, "pool_info"):
+            stats["pool"] = rgb_panel_lvgl.pool_info()
+    await client.publish(topic("display/stats"), json.dumps(stats), qos=0)
+
+
+_SNAPSHOT_FORMATS = {"raw": "rgb565", "rle": "rgb565-rle", "delta": "rgb565-delta"}
+
+
+async def _send_screenshot(msg):
+    """Stream the displayed frame in 4KB chunks; payload picks raw/rle/delta."""
+    import rgb_panel_lvgl
+
+    name = msg.decode().strip() if msg else ""
+    if name not in _SNAPSHOT_FORMATS:
+        name = "delta"
+    encoding = getattr(rgb_panel_lvgl, "SNAPSHOT_" + name.upper())
+    total = board.DISPLAY_WIDTH * board.DISPLAY_HEIGHT * 2
+    await client.publish(topic("screenshot/info"), json.dumps({
+        "w": board.DISPLAY_WIDTH, "h": board.DISPLAY_HEIGHT, "fmt": _SNAPSHOT_FORMATS[name], "size": total
+    }), qos=1)
+    # The frame is copied into PSRAM up front, so LVGL keeps rendering while
+    # the chunks are published
+    n_chunks = 0
+    sent = 0
+    for chunk in board.display_dev.snapshot_chunks(4096, encoding, copy=True):
+        await client.publish(topic(f"screenshot/{n_chunks}"), chunk, qos=1)
+        n_chunks += 1
+        sent += len(chunk)
+    await client.publish(topic("screenshot/done"), str(n_chunks), qos=1)
+    print(f"Screenshot sent: {n_chunks} chunks, {sent} bytes ({name})")
+
+
+async def _handle_trace(msg):
+    """trace: "start[:capacity]", "stop", or "dump" (Chrome JSON on trace/N)."""
+    cmd, _, arg = (msg.decode().strip() if msg else "dump").partition(":")
+    if cmd == "start":
+        trace.start(int(arg) if arg else 1024)
+        print("Trace started")
+    elif cmd == "stop":
+        trace.stop()
+        print("Trace stopped")
+    elif cmd == "dump":
+        n_chunks = 0
+        for chunk in trace.chrome_chunks():
+            await client.publish(topic(f"trace/{n_chunks}"), chunk, qos=1)
+            n_chunks += 1
+        await client.publish(topic("trace/done"), str(n_chunks), qos=1)
+        print(f"Trace sent: {n_chunks} chunks")
+
+
 # ─── Autonomous scan loop ────────────────────────────────────────────────────
 
-def _check_scale_beep(results):
+def _check_scale_beep(addresses):
     """Beep/display if a known scale MAC is present (60s debounce)."""
     global _last_beep_time
     if _scale_macs and time.ticks_diff(time.ticks_ms(), _last_beep_time) > 60000:
-        for r in results:
-            if r["address"] in _scale_macs:
+        for address in addresses:
+            if address in _scale_macs:
                 _last_beep_time = time.ticks_ms()
-                print(f"Scale detected: {r['address']}")
+                print(f"Scale detected: {address}")
                 if board.HAS_BEEP:
                     beep()
                 if board.HAS_DISPLAY:
-                    ui.on_scale_detected(r["address"])
+                    ui.on_scale_detected(address)
                 break
 
 
@@ -170,16 +258,30 @@ async def _streaming_scan_loop():
             continue
 
         try:
-            results = bridge.drain_results()
+            trace.emit(trace.SCAN_DRAIN_BEGIN)
+            if _scan_format == "packed":
+                # No device dicts at all: count from the header, beep from the table
+                payload = bridge.drain_packed()
+                count = payload[4] | payload[5] << 8
+                addresses = [m for m in _scale_macs if bridge.seen(m)]
+                results = ()
+            else:
+                results = bridge.drain_results()
+                payload = json.dumps(results)
+                count = len(results)
+                addresses = [r["address"] for r in results]
+            trace.emit(trace.SCAN_DRAIN_END, count)
             gc.collect()
-            print(f"Streaming scan: {len(results)} devices (free: {gc.mem_free()})")
+            print(f"Streaming scan: {count} devices (free: {gc.mem_free()})")
             if board.HAS_DISPLAY:
-                ui.on_scan_tick(len(results))
-            _check_scale_beep(results)
+                ui.on_scan_tick(count)
+            _check_scale_beep(addresses)
             board.on_scan_complete(results, bool(_scale_macs))
-            await client.publish(topic("scan/results"), json.dumps(results), qos=0)
+            await client.publish(topic("scan/results"), payload, qos=0)
+            trace.emit(trace.SCAN_PUBLISH, count)
             if board.HAS_DISPLAY:
                 ui.on_publish_tick()
+                await _publish_display_stats()
         except Exception as e:
             try:
                 await publish_error(f"Scan publish failed: {e}")
@@ -220,7 +322,7 @@ async def _batch_scan_loop():
             print(f"Scan done: {len(results)} devices (free: {gc.mem_free()})")
             if board.HAS_DISPLAY:
                 ui.on_scan_tick(len(results))
-            _check_scale_beep(results)
+            _check_scale_beep(r["address"] for r in results)
             # On shared-radio boards, wait for mqtt_as to reconnect after BLE disruption
             if board.DEACTIVATE_BLE_AFTER_SCAN:
                 for _ in range(30):
@@ -236,6 +338,7 @@ async def _batch_scan_loop():
             print("Results published")
             if board.HAS_DISPLAY:
                 ui.on_publish_tick()
+                await _publish_display_stats()
         except Exception as e:
             try:
                 await publish_error(f"Scan failed: {e}")
@@ -406,6 +509,7 @@ async def main():
                 elif t == topic("display/reading"):
                     if board.HAS_DISPLAY:
                         d = json.loads(msg)
+                        trace.emit(trace.READING_BEGIN)
                         ui.on_reading(
                             d.get("slug", ""),
                             d.get("name", ""),
@@ -413,6 +517,7 @@ async def main():
                             d.get("impedance"),
                             d.get("exporters", []),
                         )
+                        trace.emit(trace.READING_END)
                 elif t == topic("display/result"):
                     if board.HAS_DISPLAY:
                         d = json.loads(msg)
@@ -425,30 +530,13 @@ async def main():
                 elif t == topic("screenshot"):
                     if board.HAS_DISPLAY:
                         try:
-                            # Read directly from DMA framebuffer (not LVGL snapshot)
-                            fb = board.display_dev.framebuffer(0)
-                            if fb:
-                                raw = bytes(fb)
-                                gc.collect()
-                                # Publish in 4KB chunks over MQTT
-                                CHUNK = 4096
-                                total = len(raw)
-                                n_chunks = (total + CHUNK - 1) // CHUNK
-                                await client.publish(topic("screenshot/info"), json.dumps({
-                                    "w": board.DISPLAY_WIDTH, "h": board.DISPLAY_HEIGHT, "fmt": "rgb565", "size": total, "chunks": n_chunks
-                                }), qos=1)
-                                for i in range(n_chunks):
-                                    chunk = raw[i * CHUNK : (i + 1) * CHUNK]
-                                    await client.publish(topic(f"screenshot/{i}"), chunk, qos=1)
-                                    await asyncio.sleep_ms(20)
-                                await client.publish(topic("screenshot/done"), str(n_chunks), qos=1)
-                                print(f"Screenshot sent: {n_chunks} chunks")
-                                gc.collect()
-                            else:
-                                print("Screenshot failed")
+                            await _send_screenshot(msg)
                         except Exception as e:
                             import sys
                             sys.print_exception(e)
+                elif t == topic("trace"):
+                    if board.HAS_DISPLAY:
+                        await _handle_trace(msg)
                 elif t.startswith(topic("write/")):
                     uuid_str = t[len(topic("write/")):]
                     await handle_write(uuid_str, msg)
@@ -1,7 +1,9 @@
 """ST7701S panel init sequence for Guition ESP32-S3-4848S040 (480x480).
 
 Format: list of (command, data_bytes_or_None, delay_ms).
-Sent via SPI 3-wire bit-bang by the rgb_panel_lvgl C driver.
+Sent via SPI 3-wire by the rgb_panel_lvgl C driver.  After editing, re-run
+firmware/tools/pack_init_cmds.py on this file to regenerate the packed
+panel_init_guition_4848_blob.py that the board actually sends.
 """
 
 INIT_CMDS = [
@@ -0,0 +1,25 @@
+"""Packed form of panel_init_guition_4848.py INIT_CMDS for rgb_panel_lvgl.
+
+Generated by firmware/tools/pack_init_cmds.py — do not edit, re-run the tool.
+Record format: cmd:u8  len:u8  data[len]  delay_ms:u8
+"""
+
+INIT_BLOB = (
+    b"\xff\x05\x77\x01\x00\x00\x10\x00\xc0\x02\x3b\x00\x00\xc1\x02\x0d"
+    b"\x02\x00\xc2\x02\x31\x05\x00\xcd\x01\x00\x00\xb0\x10\x00\x11\x18"
+    b"\x0e\x11\x06\x07\x08\x07\x22\x04\x12\x0f\xaa\x31\x18\x00\xb1\x10"
+    b"\x00\x11\x19\x0e\x12\x07\x08\x08\x08\x22\x04\x11\x11\xa9\x32\x18"
+    b"\x00\xff\x05\x77\x01\x00\x00\x11\x00\xb0\x01\x60\x00\xb1\x01\x32"
+    b"\x00\xb2\x01\x07\x00\xb3\x01\x80\x00\xb5\x01\x49\x00\xb7\x01\x85"
+    b"\x00\xb8\x01\x21\x00\xc1\x01\x78\x00\xc2\x01\x78\x00\xe0\x03\x00"
+    b"\x1b\x02\x00\xe1\x0b\x08\xa0\x00\x00\x07\xa0\x00\x00\x00\x44\x44"
+    b"\x00\xe2\x0c\x11\x11\x44\x44\xed\xa0\x00\x00\xec\xa0\x00\x00\x00"
+    b"\xe3\x04\x00\x00\x11\x11\x00\xe4\x02\x44\x44\x00\xe5\x10\x0a\xe9"
+    b"\xd8\xa0\x0c\xeb\xd8\xa0\x0e\xed\xd8\xa0\x10\xef\xd8\xa0\x00\xe6"
+    b"\x04\x00\x00\x11\x11\x00\xe7\x02\x44\x44\x00\xe8\x10\x09\xe8\xd8"
+    b"\xa0\x0b\xea\xd8\xa0\x0d\xec\xd8\xa0\x0f\xee\xd8\xa0\x00\xeb\x07"
+    b"\x02\x00\xe4\xe4\x88\x00\x40\x00\xec\x02\x3c\x00\x00\xed\x10\xab"
+    b"\x89\x76\x54\x02\xff\xff\xff\xff\xff\xff\x20\x45\x67\x98\xba\x00"
+    b"\xff\x05\x77\x01\x00\x00\x13\x00\xe5\x01\xe4\x00\xff\x05\x77\x01"
+    b"\x00\x00\x00\x00\x3a\x01\x50\x00\x11\x00\x78\x29\x00\x14"
+)
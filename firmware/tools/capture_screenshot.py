@@ -2,10 +2,12 @@
 """Capture a screenshot from the ESP32 display via MQTT.
 
 Usage:
-    python3 firmware/tools/capture_screenshot.py [output.png]
+    python3 firmware/tools/capture_screenshot.py [output.png] [raw|rle|delta]
 
 Triggers a screenshot, receives RGB565 data over MQTT, converts to PNG.
 Waits patiently for chunks that arrive between BLE scan WiFi drops.
+The encoding defaults to delta (row XOR + RLE), usually a few percent of
+the raw frame for a UI screen.
 """
 
 import os
@@ -18,26 +20,57 @@ import time
 BROKER = os.environ.get("BROKER", "10.1.1.15")
 BASE = os.environ.get("BASE", "ble-proxy/esp32-ble-proxy")
 OUTPUT = sys.argv[1] if len(sys.argv) > 1 else "/tmp/screenshot.png"
-
-W, H = 480, 480
-EXPECTED_SIZE = W * H * 2  # RGB565
+ENCODING = sys.argv[2] if len(sys.argv) > 2 else "delta"
+
+
+def decode_rle(data):
+    """Decode rgb_panel_lvgl RLE packets into raw little-endian RGB565."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        head = data[i]
+        i += 1
+        if head & 0x80:
+            out += data[i : i + 2] * ((head & 0x7F) + 1)
+            i += 2
+        else:
+            n = (head + 1) * 2
+            out += data[i : i + n]
+            i += n
+    return bytes(out)
+
+
+def undelta(raw, width):
+    """Undo the row XOR applied by the delta encoding."""
+    px = list(struct.unpack(f"<{len(raw) // 2}H", raw))
+    for i in range(width, len(px)):
+        px[i] ^= px[i - width]
+    return struct.pack(f"<{len(px)}H", *px)
 
 
 def main():
+    import json
     import paho.mqtt.client as mqtt
 
-    CHUNK_SIZE = 4096
-    n_chunks = (EXPECTED_SIZE + CHUNK_SIZE - 1) // CHUNK_SIZE  # 113
     chunks = {}
+    meta = {}
 
     def on_message(client, userdata, msg):
         t = msg.topic
-        if t.startswith(f"{BASE}/screenshot/"):
+        if t == f"{BASE}/screenshot/info":
+            meta["info"] = json.loads(msg.payload)
+        elif t == f"{BASE}/screenshot/done":
+            meta["done"] = int(msg.payload)
+        elif t.startswith(f"{BASE}/screenshot/"):
             try:
                 idx = int(t.split("/")[-1])
                 chunks[idx] = msg.payload
             except ValueError:
-                pass  # info, done — ignore
+                pass
+
+    def complete():
+        n = meta.get("done")
+        return n is not None and all(i in chunks for i in range(n))
 
     client = mqtt.Client()
     client.on_message = on_message
@@ -46,8 +79,8 @@ def main():
     client.loop_start()
 
     for attempt in range(1, 4):
-        client.publish(f"{BASE}/screenshot", "", qos=1)
-        print(f"Screenshot triggered (attempt {attempt}), waiting for {n_chunks} chunks...")
+        client.publish(f"{BASE}/screenshot", ENCODING, qos=1)
+        print(f"Screenshot triggered (attempt {attempt}, {ENCODING}), waiting for chunks...")
 
         timeout = time.time() + 45
         last_count = 0
@@ -55,31 +88,38 @@ def main():
             time.sleep(1)
             count = len(chunks)
             if count != last_count:
-                print(f"  {count}/{n_chunks} chunks received...")
+                print(f"  {count} chunks received...")
                 last_count = count
-            if count >= n_chunks:
+            if complete():
                 break
-        if len(chunks) >= n_chunks:
+        if complete():
             break
-        missing = [i for i in range(n_chunks) if i not in chunks]
-        print(f"  Missing {len(missing)} chunks, retrying...")
+        print("  Incomplete, retrying...")
+        chunks.clear()  # chunk boundaries of an encoded frame don't line up across attempts
+        meta.clear()
 
     client.loop_stop()
     client.disconnect()
 
-    missing = [i for i in range(n_chunks) if i not in chunks]
-    if missing:
-        print(f"Missing {len(missing)} chunks: {missing[:20]}...")
+    if not complete():
+        print("Screenshot incomplete")
         sys.exit(1)
 
-    print(f"All {n_chunks} chunks received!")
+    n_chunks = meta["done"]
+    info = meta["info"]
+    w, h, fmt = info["w"], info["h"], info["fmt"]
+    print(f"All {n_chunks} chunks received ({fmt})!")
 
-    # Reassemble
-    raw = b""
-    for i in range(n_chunks):
-        raw += chunks[i]
+    # Reassemble; encoded chunks each end on a packet boundary
+    data = b"".join(chunks[i] for i in range(n_chunks))
+    if fmt == "rgb565":
+        raw = data
+    else:
+        raw = decode_rle(data)
+        if fmt == "rgb565-delta":
+            raw = undelta(raw, w)
 
-    print(f"Total size: {len(raw)} bytes (expected {EXPECTED_SIZE})")
+    print(f"Received {len(data)} bytes, {len(raw)} decoded (expected {info['size']})")
 
     # Convert RGB565 to RGB888 PNG
     pixels = []
@@ -91,7 +131,7 @@ def main():
         pixels.extend([r, g, b])
 
     from PIL import Image
-    img = Image.frombytes("RGB", (W, H), bytes(pixels))
+    img = Image.frombytes("RGB", (w, h), bytes(pixels))
     img.save(OUTPUT)
     print(f"Saved to {OUTPUT}")
 
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Record an end-to-end latency trace from the ESP32 display board via MQTT.
+
+Usage:
+    python3 firmware/tools/capture_trace.py [output.json] [seconds]
+
+Starts the trace ring, waits while you step on the scale (default 60 s),
+then dumps the ring as Chrome trace JSON. Open the file in
+chrome://tracing or https://ui.perfetto.dev to see where the time goes
+between the BLE stack, MQTT, the UI code and the panel's frame swaps.
+"""
+
+import os
+import sys
+import time
+
+# ── Configuration ───────────────────────────────────────
+# Override via environment variables, or edit these defaults.
+BROKER = os.environ.get("BROKER", "10.1.1.15")
+BASE = os.environ.get("BASE", "ble-proxy/esp32-ble-proxy")
+CAPACITY = int(os.environ.get("TRACE_CAPACITY", "4096"))
+OUTPUT = sys.argv[1] if len(sys.argv) > 1 else "/tmp/trace.json"
+SECONDS = float(sys.argv[2]) if len(sys.argv) > 2 else 60
+
+
+def main():
+    import json
+    import paho.mqtt.client as mqtt
+
+    chunks = {}
+    meta = {}
+
+    def on_message(client, userdata, msg):
+        t = msg.topic
+        if t == f"{BASE}/trace/done":
+            meta["done"] = int(msg.payload)
+        elif t.startswith(f"{BASE}/trace/"):
+            try:
+                chunks[int(t.split("/")[-1])] = msg.payload
+            except ValueError:
+                pass
+
+    def complete():
+        n = meta.get("done")
+        return n is not None and all(i in chunks for i in range(n))
+
+    client = mqtt.Client()
+    client.on_message = on_message
+    client.connect(BROKER)
+    client.subscribe(f"{BASE}/trace/#", qos=1)
+    client.loop_start()
+
+    client.publish(f"{BASE}/trace", f"start:{CAPACITY}", qos=1)
+    print(f"Tracing for {SECONDS:.0f} s ({CAPACITY} events max)...")
+    time.sleep(SECONDS)
+
+    client.publish(f"{BASE}/trace", "dump", qos=1)
+    timeout = time.time() + 45
+    while time.time() < timeout and not complete():
+        time.sleep(1)
+    client.publish(f"{BASE}/trace", "stop", qos=1)
+    time.sleep(0.5)
+    client.loop_stop()
+    client.disconnect()
+
+    if not complete():
+        print("Trace incomplete")
+        sys.exit(1)
+
+    data = b"".join(chunks[i] for i in range(meta["done"]))
+    trace = json.loads(data)
+    with open(OUTPUT, "w") as f:
+        json.dump(trace, f)
+    events = sum(1 for e in trace["traceEvents"] if e["ph"] != "M")
+    print(f"Saved {events} events to {OUTPUT} ({trace['otherData']['lost_events']} overwritten)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Pack a panel INIT_CMDS tuple list into the rgb_panel_lvgl binary format.
+
+Usage:
+    python3 firmware/tools/pack_init_cmds.py firmware/panel_init_guition_4848.py
+
+Reads INIT_CMDS from the given module and writes <module>_blob.py next to
+it, holding the same sequence as a single bytes constant (INIT_BLOB).
+Frozen into the firmware, that constant lives in flash and RGBPanel sends it
+without building a list on the MicroPython heap.
+
+Blob format, one record per command:
+    cmd:u8  len:u8  data[len]  delay_ms:u8
+"""
+
+import os
+import sys
+
+BYTES_PER_LINE = 16
+
+
+def pack(init_cmds):
+    """Return the packed blob for a list of (cmd, data_or_None, delay_ms)."""
+    out = bytearray()
+    for i, entry in enumerate(init_cmds):
+        cmd = entry[0]
+        data = entry[1] if len(entry) > 1 and entry[1] is not None else []
+        delay_ms = entry[2] if len(entry) > 2 else 0
+        if not 0 <= cmd <= 0xFF:
+            raise ValueError(f"entry {i}: command 0x{cmd:X} does not fit in a byte")
+        if len(data) > 0xFF:
+            raise ValueError(f"entry {i}: {len(data)} data bytes, max 255")
+        if not 0 <= delay_ms <= 0xFF:
+            raise ValueError(f"entry {i}: delay {delay_ms} ms, max 255")
+        out.append(cmd)
+        out.append(len(data))
+        out.extend(data)
+        out.append(delay_ms)
+    return bytes(out)
+
+
+def load_init_cmds(path):
+    namespace = {}
+    with open(path) as f:
+        exec(compile(f.read(), path, "exec"), namespace)
+    if "INIT_CMDS" not in namespace:
+        raise SystemExit(f"{path}: no INIT_CMDS list")
+    return namespace["INIT_CMDS"]
+
+
+def render(blob, source_name):
+    lines = [
+        f'"""Packed form of {source_name} INIT_CMDS for rgb_panel_lvgl.',
+        "",
+        "Generated by firmware/tools/pack_init_cmds.py — do not edit, re-run the tool.",
+        "Record format: cmd:u8  len:u8  data[len]  delay_ms:u8",
+        '"""',
+        "",
+        "INIT_BLOB = (",
+    ]
+    for i in range(0, len(blob), BYTES_PER_LINE):
+        chunk = blob[i : i + BYTES_PER_LINE]
+        lines.append('    b"' + "".join(f"\\x{b:02x}" for b in chunk) + '"')
+    lines.append(")")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    if len(sys.argv) != 2:
+        print("usage: pack_init_cmds.py <panel_init_module.py>", file=sys.stderr)
+        sys.exit(2)
+
+    src = sys.argv[1]
+    blob = pack(load_init_cmds(src))
+    base, _ = os.path.splitext(src)
+    dst = base + "_blob.py"
+    with open(dst, "w") as f:
+        f.write(render(blob, os.path.basename(src)))
+    print(f"Wrote {dst}: {len(blob)} bytes")
+
+
+if __name__ == "__main__":
+    main()
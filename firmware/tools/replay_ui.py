@@ -0,0 +1,168 @@
+"""Replay the ui.py screens on the host build and count render work.
+
+Runs under the host MicroPython from `drivers/build.sh unix`, not CPython:
+
+    drivers/_build/micropython-host firmware/tools/replay_ui.py [options]
+
+      --partial        render in RENDER_PARTIAL mode instead of DIRECT
+      --write FILE     save the result as a baseline
+      --check FILE     compare against a baseline, exit 1 if any step got more
+                       expensive (more pixels, flushes or bytes copied)
+
+Drives ui.py through a fixed sequence of state changes (startup, connect,
+scale detected, readings, result, timeout back to idle) and forces one LVGL
+refresh after each.  Per step it reports the pixels LVGL rendered and
+flushed, flush calls, buffer swaps and the bytes copied: the DIRECT sync copy
+(attributed to the step that dirtied the area, although the driver runs it
+once the swap latches, at the next refresh) or the PARTIAL strip copies.  The counts only depend on
+the UI and driver code, so a change in the dirty-area or copy strategy shows
+up as a diff against the baseline.  The result is the last line printed, as
+JSON.
+"""
+
+import json
+import sys
+import time
+
+_here = __file__.rsplit("/", 1)[0] if "/" in __file__ else "."
+sys.path.insert(0, _here + "/..")
+
+import board  # noqa: E402  (firmware/ must be on the path first)
+import ui  # noqa: E402
+
+_KEYS = ("px", "flushes", "copy_bytes", "swaps")
+
+_EXPORTERS = ["Garmin", "MQTT", "InfluxDB"]
+_EXPORTS = [{"name": "Garmin", "ok": True}, {"name": "MQTT", "ok": True}, {"name": "InfluxDB", "ok": False}]
+
+
+def _timeout_to_idle():
+    # check_timeout() compares against the real clock: backdate the state and
+    # the indicator flashes so the result does not depend on how fast we ran
+    past = time.ticks_add(time.ticks_ms(), -(ui._RESULT_TIMEOUT_MS + 1))
+    ui._state_entered = past
+    if ui._scan_flash_time:
+        ui._scan_flash_time = past
+    if ui._pub_flash_time:
+        ui._pub_flash_time = past
+    ui.check_timeout()
+
+
+STEPS = (
+    ("startup", lambda: None),
+    ("wifi_up", lambda: ui.on_wifi_change(True)),
+    ("mqtt_up", lambda: ui.on_mqtt_change(True)),
+    ("users", lambda: ui.on_config_update([{"slug": "alice"}, {"slug": "bob"}])),
+    ("scale_macs", lambda: ui.on_scale_macs_update(True)),
+    ("scan_tick", lambda: ui.on_scan_tick(12)),
+    ("publish_tick", ui.on_publish_tick),
+    ("scale_detected", lambda: ui.on_scale_detected("AA:BB:CC:DD:EE:FF")),
+    ("reading", lambda: ui.on_reading("alice", "Alice", 72.4, 500, _EXPORTERS)),
+    ("reading_same", lambda: ui.on_reading("alice", "Alice", 72.4, 500, _EXPORTERS)),
+    ("reading_update", lambda: ui.on_reading("alice", "Alice", 72.6, 498, _EXPORTERS)),
+    ("result", lambda: ui.on_result("alice", "Alice", 72.6, _EXPORTS)),
+    ("timeout_idle", _timeout_to_idle),
+    ("wifi_down", lambda: ui.on_wifi_change(False)),
+)
+
+
+def replay():
+    import lvgl as lv
+    import rgb_panel_lvgl as rp
+
+    ui.init()
+    disp = board.display_dev
+    if disp is None:
+        raise RuntimeError("display init failed")
+    disp.stats()   # drop anything counted during init
+
+    steps = []
+    pending = 0
+    swaps = rp.sim_info()["swaps"]
+    for name, fn in STEPS:
+        fn()
+        lv.refr_now(None)
+        w = disp.stats()["window"]
+        sync = disp.sync_info()
+        # bytes_copied holds the previous step's deferred sync copy (DIRECT)
+        copy = w["bytes_copied"] - pending + sync["pending"]
+        pending = sync["pending"]
+        now_swaps = rp.sim_info()["swaps"]
+        steps.append({
+            "step": name,
+            "px": w["px"],
+            "flushes": w["flushes"],
+            "copy_bytes": copy,
+            "swaps": now_swaps - swaps,
+        })
+        swaps = now_swaps
+
+    total = {k: sum(s[k] for s in steps) for k in _KEYS}
+    return {
+        "mode": "partial" if board.RENDER_MODE else "direct",
+        "width": board.DISPLAY_WIDTH,
+        "height": board.DISPLAY_HEIGHT,
+        "steps": steps,
+        "total": total,
+    }
+
+
+def check(result, baseline):
+    """Print differences against baseline; True when nothing got worse."""
+    ok = True
+    if baseline.get("mode") != result["mode"]:
+        print("baseline is for %s mode" % baseline.get("mode"))
+        return False
+    base_steps = {s["step"]: s for s in baseline["steps"]}
+    for s in result["steps"]:
+        b = base_steps.get(s["step"])
+        if b is None:
+            print("%-16s new step" % s["step"])
+            continue
+        for k in _KEYS:
+            if s[k] != b.get(k):
+                worse = s[k] > b.get(k, 0)
+                ok = ok and not worse
+                print("%-16s %-10s %d -> %d%s" % (s["step"], k, b.get(k, 0), s[k],
+                                                 "  REGRESSION" if worse else ""))
+    return ok
+
+
+def main(argv):
+    write = check_file = None
+    i = 1
+    while i < len(argv):
+        arg = argv[i]
+        if arg == "--partial":
+            import board_host
+            board_host.RENDER_MODE = 1
+            board.RENDER_MODE = 1
+        elif arg in ("--write", "--check") and i + 1 < len(argv):
+            i += 1
+            if arg == "--write":
+                write = argv[i]
+            else:
+                check_file = argv[i]
+        else:
+            print(__doc__)
+            return 2
+        i += 1
+
+    if board.BOARD_NAME != "host":
+        print("replay_ui.py needs the host build (board %s)" % board.BOARD_NAME)
+        return 2
+
+    result = replay()
+    status = 0
+    if check_file:
+        with open(check_file) as f:
+            if not check(result, json.load(f)):
+                status = 1
+    if write:
+        with open(write, "w") as f:
+            json.dump(result, f)
+    print(json.dumps(result))
+    return status
+
+
+sys.exit(main(sys.argv))
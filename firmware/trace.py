@@ -0,0 +1,116 @@
+"""Latency tracing from BLE advertisement/notification to the panel.
+
+Python side of the rgb_panel_lvgl trace ring. The display driver records
+its own render events (refresh, flush, frame swap in the VSYNC ISR); the
+bridge adds the BLE and MQTT stages below. chrome_chunks() turns a read-out
+into Chrome trace JSON (chrome://tracing, ui.perfetto.dev) in pieces small
+enough to publish.
+
+On boards without the display driver every call is a no-op.
+"""
+
+try:
+    import rgb_panel_lvgl as _rp
+except ImportError:
+    _rp = None
+
+_native = _rp is not None and hasattr(_rp, "trace")
+_USER = _rp.TRACE_USER if _native else 64
+
+# Python-side event ids
+SCAN_DRAIN_BEGIN = _USER
+SCAN_DRAIN_END = _USER + 1
+SCAN_PUBLISH = _USER + 2       # arg = devices
+NOTIFY_RX = _USER + 3          # stamped at arrival in the NimBLE callback
+NOTIFY_PUBLISH = _USER + 4     # arg = bytes
+READING_RX = _USER + 5         # display/reading delivered by MQTT
+READING_BEGIN = _USER + 6      # ui.on_reading()
+READING_END = _USER + 7
+
+# Chrome thread rows
+_TIDS = {"isr": 1, "lvgl": 2, "ble": 3, "mqtt": 4, "ui": 5}
+
+# id -> (name, phase, row); B/E pairs become spans, i is an instant
+_EVENTS = {
+    SCAN_DRAIN_BEGIN: ("drain_results", "B", "ble"),
+    SCAN_DRAIN_END: ("drain_results", "E", "ble"),
+    SCAN_PUBLISH: ("scan/results publish", "i", "mqtt"),
+    NOTIFY_RX: ("notify rx", "i", "ble"),
+    NOTIFY_PUBLISH: ("notify publish", "i", "mqtt"),
+    READING_RX: ("display/reading rx", "i", "mqtt"),
+    READING_BEGIN: ("ui.on_reading", "B", "ui"),
+    READING_END: ("ui.on_reading", "E", "ui"),
+}
+if _native:
+    _EVENTS.update({
+        _rp.TRACE_REFR_START: ("refresh", "i", "lvgl"),
+        _rp.TRACE_FLUSH_BEGIN: ("flush", "B", "lvgl"),
+        _rp.TRACE_FLUSH_END: ("flush", "E", "lvgl"),
+        _rp.TRACE_SWAP_QUEUED: ("swap queued", "i", "lvgl"),
+        _rp.TRACE_SWAP: ("frame swap", "i", "isr"),
+        _rp.TRACE_TIMER_BEGIN: ("lv_timer_handler", "B", "lvgl"),
+        _rp.TRACE_TIMER_END: ("lv_timer_handler", "E", "lvgl"),
+    })
+
+_REC = 12  # t_us:u32 id:u16 reserved:u16 arg:i32
+
+
+def start(capacity=1024):
+    if _native:
+        _rp.trace_start(capacity)
+
+
+def stop():
+    if _native:
+        _rp.trace_stop()
+
+
+def emit(event_id, arg=0, ticks_us=None):
+    """Record an event now, or at an earlier time.ticks_us() value."""
+    if _native:
+        _rp.trace(event_id, arg, ticks_us)
+
+
+def chrome_chunks(events_per_chunk=128):
+    """Yield the recorded trace as Chrome trace JSON text, in pieces."""
+    if not _native:
+        raw, lost = b"", 0
+    else:
+        raw, lost = _rp.trace_read()
+    import struct
+
+    n = len(raw) // _REC
+    # Timestamps are 32-bit microseconds: make them relative to the earliest
+    # event (events may be recorded out of order, e.g. back-dated notifies)
+    base = struct.unpack_from("<I", raw, 0)[0] if n else 0
+    low = 0
+    for i in range(n):
+        rel = (struct.unpack_from("<I", raw, i * _REC)[0] - base) & 0xFFFFFFFF
+        if rel >= 0x80000000:
+            rel -= 0x100000000
+        if rel < low:
+            low = rel
+
+    # Thread names first, then one event per record, comma-separated across chunks
+    parts = ['{"traceEvents":[']
+    sep = ""
+    for row, tid in _TIDS.items():
+        parts.append(
+            '%s{"name":"thread_name","ph":"M","pid":1,"tid":%d,"args":{"name":"%s"}}' % (sep, tid, row)
+        )
+        sep = ","
+    for i in range(n):
+        t, event_id, _, arg = struct.unpack_from("<IHHi", raw, i * _REC)
+        rel = (t - base) & 0xFFFFFFFF
+        if rel >= 0x80000000:
+            rel -= 0x100000000
+        name, ph, row = _EVENTS.get(event_id, ("event %d" % event_id, "i", "ui"))
+        parts.append(
+            ',{"name":"%s","ph":"%s","ts":%d,"pid":1,"tid":%d,%s"args":{"arg":%d}}'
+            % (name, ph, rel - low, _TIDS[row], '"s":"t",' if ph == "i" else "", arg)
+        )
+        if len(parts) >= events_per_chunk:
+            yield "".join(parts)
+            parts = []
+    parts.append('],"otherData":{"lost_events":%d}}' % lost)
+    yield "".join(parts)
@@ -9,12 +9,23 @@ States: STARTUP -> IDLE -> SCALE_DETECTED -> READING -> RESULT -> IDLE
 
 Hardware init is handled by board_guition_4848.init_display() using the
 rgb_panel_lvgl C module.  This module only manages the UI layer on top.
-LVGL tick is driven by an esp_timer in the C driver (no Python tick_inc needed).
+The C driver supplies LVGL's tick (no Python tick_inc needed).  Boards with
+REFRESH_ACTIVE_MS / REFRESH_IDLE_MS get a faster refresh while a reading is
+on screen (see _set_state).
+On boards with LVGL_TASK the driver also renders from its own task; widget
+updates then run under the display lock (see _locked).
+State changes hand their widget updates to the driver in one apply() call,
+which skips the ones that change nothing (see _apply).
 """
 
 import time
 import board
 
+try:
+    from rgb_panel_lvgl import PROP_TEXT, PROP_TEXT_COLOR, PROP_HIDDEN
+except ImportError:
+    PROP_TEXT = PROP_TEXT_COLOR = PROP_HIDDEN = None  # no display on this board
+
 # ─── State constants ──────────────────────────────────────────────────────────
 
 STARTUP = 0
@@ -51,6 +62,8 @@ _state = STARTUP
 _state_entered = 0
 _users = []
 _initialised = False
+_disp = None  # display object used as LVGL lock when the C task renders
+_fonts = {}  # size -> font, see _font()
 
 # Connection state
 _wifi_connected = False
@@ -65,6 +78,7 @@ _lbl_status = None
 _lbl_startup_sub = None
 _lbl_name = None
 _lbl_weight = None
+_weight_atlas = None  # rgb_panel_lvgl.DigitAtlas drawing into _lbl_weight
 _lbl_exporters = None
 
 # Status bar
@@ -87,6 +101,14 @@ def _set_state(new_state):
     global _state, _state_entered
     _state = new_state
     _state_entered = time.ticks_ms()
+    # Before the new screen is built, so its first frame already uses the period
+    live = new_state in (SCALE_DETECTED, READING)
+    ms = getattr(board, "REFRESH_ACTIVE_MS" if live else "REFRESH_IDLE_MS", None)
+    if ms:
+        board.display_dev.refresh_period(ms)
+    # Any state change is activity: restart the auto-dim timeout, light up
+    if getattr(board, "AUTO_DIM_MS", 0):
+        board.display_dev.wake()
 
 
 def _elapsed_ms():
@@ -98,16 +120,59 @@ def _color(hex_val):
     return lv.color_hex(hex_val)
 
 
+def _font(size):
+    """Montserrat at size px, through the driver's glyph cache when it has one."""
+    font = _fonts.get(size)
+    if font is None:
+        import lvgl as lv
+        font = getattr(lv, "font_montserrat_%d" % size)
+        try:
+            import rgb_panel_lvgl
+            font = lv.font_t.__cast__(rgb_panel_lvgl.cached_font(font))
+        except (ImportError, AttributeError):
+            pass
+        _fonts[size] = font
+    return font
+
+
+def _set_weight(weight):
+    text = f"{weight:.1f} kg"
+    if _weight_atlas is not None:
+        _weight_atlas.set_text(text)
+    else:
+        _lbl_weight.set_text(text)
+
+
+def _apply(updates):
+    """(widget, PROP_*, value) updates in one driver call; colors as 0xRRGGBB."""
+    board.display_dev.apply(updates)
+
+
+def _content(status, sub, reading):
+    """Visibility of the content labels, as apply() updates."""
+    return [
+        (_lbl_status, PROP_HIDDEN, not status),
+        (_lbl_startup_sub, PROP_HIDDEN, not sub),
+        (_lbl_name, PROP_HIDDEN, not reading),
+        (_lbl_weight, PROP_HIDDEN, not reading),
+        (_lbl_exporters, PROP_HIDDEN, not reading),
+    ]
+
+
+def _locked(fn):
+    """Run fn holding the display's LVGL lock when the C task renders."""
+    def wrapper(*args):
+        if _disp is None:
+            return fn(*args)
+        with _disp:
+            return fn(*args)
+    return wrapper
+
+
 # ─── Init ─────────────────────────────────────────────────────────────────────
 
 def init():
-    global _initialised
-    global _hdr, _lbl_hdr_title, _lbl_hdr_scale
-    global _lbl_users, _lbl_status, _lbl_startup_sub
-    global _lbl_name, _lbl_weight, _lbl_exporters
-    global _sbar, _lbl_wifi_icon, _lbl_wifi_text
-    global _lbl_mqtt_icon, _lbl_mqtt_text
-    global _lbl_ble_icon, _lbl_ble_text
+    global _initialised, _disp
 
     if not board.HAS_DISPLAY:
         return
@@ -127,6 +192,25 @@ def init():
         return
     # Store display object in board module namespace for screenshot access
     board.display_dev = result
+    if board.LVGL_TASK:
+        _disp = result
+
+    _create_widgets()
+
+    _initialised = True
+    _set_state(STARTUP)
+    print("UI initialised (STARTUP)")
+
+
+@_locked
+def _create_widgets():
+    global _hdr, _lbl_hdr_title, _lbl_hdr_scale
+    global _lbl_users, _lbl_status, _lbl_startup_sub
+    global _lbl_name, _lbl_weight, _lbl_exporters, _weight_atlas
+    global _sbar, _lbl_wifi_icon, _lbl_wifi_text
+    global _lbl_mqtt_icon, _lbl_mqtt_text
+    global _lbl_ble_icon, _lbl_ble_text
+    import lvgl as lv
 
     scr = lv.screen_active()
     scr.set_style_bg_color(_color(_BG), 0)
@@ -145,13 +229,13 @@ def init():
     _lbl_hdr_title = lv.label(_hdr)
     _lbl_hdr_title.set_text("BLE Scale Sync")
     _lbl_hdr_title.set_style_text_color(_color(_SLATE_200), 0)
-    _lbl_hdr_title.set_style_text_font(lv.font_montserrat_16, 0)
+    _lbl_hdr_title.set_style_text_font(_font(16), 0)
     _lbl_hdr_title.align(lv.ALIGN.LEFT_MID, 16, 0)
 
     _lbl_hdr_scale = lv.label(_hdr)
     _lbl_hdr_scale.set_text(lv.SYMBOL.BLUETOOTH)
     _lbl_hdr_scale.set_style_text_color(_color(_DIM), 0)
-    _lbl_hdr_scale.set_style_text_font(lv.font_montserrat_14, 0)
+    _lbl_hdr_scale.set_style_text_font(_font(14), 0)
     _lbl_hdr_scale.align(lv.ALIGN.RIGHT_MID, -16, 0)
     _lbl_hdr_scale.add_flag(lv.obj.FLAG.HIDDEN)
 
@@ -161,14 +245,14 @@ def init():
     _lbl_users = lv.label(scr)
     _lbl_users.set_text("")
     _lbl_users.set_style_text_color(_color(_DIM_TEXT), 0)
-    _lbl_users.set_style_text_font(lv.font_montserrat_12, 0)
+    _lbl_users.set_style_text_font(_font(12), 0)
     _lbl_users.align(lv.ALIGN.TOP_RIGHT, -20, 64)
 
     # Status text (big, centered)
     _lbl_status = lv.label(scr)
     _lbl_status.set_text("Connecting...")
     _lbl_status.set_style_text_color(_color(_INDIGO), 0)
-    _lbl_status.set_style_text_font(lv.font_montserrat_28, 0)
+    _lbl_status.set_style_text_font(_font(28), 0)
     _lbl_status.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_status.set_width(440)
     _lbl_status.align(lv.ALIGN.TOP_MID, 0, 190)
@@ -177,7 +261,7 @@ def init():
     _lbl_startup_sub = lv.label(scr)
     _lbl_startup_sub.set_text("WiFi: connecting...")
     _lbl_startup_sub.set_style_text_color(_color(_MUTED), 0)
-    _lbl_startup_sub.set_style_text_font(lv.font_montserrat_14, 0)
+    _lbl_startup_sub.set_style_text_font(_font(14), 0)
     _lbl_startup_sub.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_startup_sub.set_width(440)
     _lbl_startup_sub.align(lv.ALIGN.TOP_MID, 0, 235)
@@ -186,7 +270,7 @@ def init():
     _lbl_name = lv.label(scr)
     _lbl_name.set_text("")
     _lbl_name.set_style_text_color(_color(_INDIGO_200), 0)
-    _lbl_name.set_style_text_font(lv.font_montserrat_20, 0)
+    _lbl_name.set_style_text_font(_font(20), 0)
     _lbl_name.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_name.set_width(440)
     _lbl_name.align(lv.ALIGN.TOP_MID, 0, 140)
@@ -196,17 +280,25 @@ def init():
     _lbl_weight = lv.label(scr)
     _lbl_weight.set_text("")
     _lbl_weight.set_style_text_color(_color(_WHITE), 0)
-    _lbl_weight.set_style_text_font(lv.font_montserrat_28, 0)
+    _lbl_weight.set_style_text_font(_font(28), 0)
     _lbl_weight.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_weight.set_width(440)
     _lbl_weight.align(lv.ALIGN.TOP_MID, 0, 190)
     _lbl_weight.add_flag(lv.obj.FLAG.HIDDEN)
+    # Live weight from pre-rendered glyphs; the label text stays empty
+    try:
+        from rgb_panel_lvgl import DigitAtlas
+        _weight_atlas = DigitAtlas(_font(28), _WHITE)
+        _weight_atlas.attach(_lbl_weight)
+        _lbl_weight.set_height(_weight_atlas.info()["line_height"])
+    except (ImportError, ValueError, MemoryError):
+        _weight_atlas = None
 
     # Exporter list
     _lbl_exporters = lv.label(scr)
     _lbl_exporters.set_text("")
     _lbl_exporters.set_style_text_color(_color(_SLATE_400), 0)
-    _lbl_exporters.set_style_text_font(lv.font_montserrat_14, 0)
+    _lbl_exporters.set_style_text_font(_font(14), 0)
     _lbl_exporters.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_exporters.set_width(400)
     _lbl_exporters.align(lv.ALIGN.TOP_MID, 0, 260)
@@ -227,7 +319,7 @@ def init():
     _lbl_wifi_icon = lv.label(_sbar)
     _lbl_wifi_icon.set_text(lv.SYMBOL.WIFI)
     _lbl_wifi_icon.set_style_text_color(_color(_RED), 0)
-    _lbl_wifi_icon.set_style_text_font(lv.font_montserrat_14, 0)
+    _lbl_wifi_icon.set_style_text_font(_font(14), 0)
     _lbl_wifi_icon.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_wifi_icon.set_width(160)
     _lbl_wifi_icon.set_pos(0, 10)
@@ -235,7 +327,7 @@ def init():
     _lbl_wifi_text = lv.label(_sbar)
     _lbl_wifi_text.set_text("WiFi")
     _lbl_wifi_text.set_style_text_color(_color(_RED), 0)
-    _lbl_wifi_text.set_style_text_font(lv.font_montserrat_12, 0)
+    _lbl_wifi_text.set_style_text_font(_font(12), 0)
     _lbl_wifi_text.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_wifi_text.set_width(160)
     _lbl_wifi_text.set_pos(0, 32)
@@ -244,7 +336,7 @@ def init():
     _lbl_mqtt_icon = lv.label(_sbar)
     _lbl_mqtt_icon.set_text(lv.SYMBOL.UPLOAD)
     _lbl_mqtt_icon.set_style_text_color(_color(_RED), 0)
-    _lbl_mqtt_icon.set_style_text_font(lv.font_montserrat_14, 0)
+    _lbl_mqtt_icon.set_style_text_font(_font(14), 0)
     _lbl_mqtt_icon.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_mqtt_icon.set_width(160)
     _lbl_mqtt_icon.set_pos(160, 10)
@@ -252,7 +344,7 @@ def init():
     _lbl_mqtt_text = lv.label(_sbar)
     _lbl_mqtt_text.set_text("MQTT")
     _lbl_mqtt_text.set_style_text_color(_color(_RED), 0)
-    _lbl_mqtt_text.set_style_text_font(lv.font_montserrat_12, 0)
+    _lbl_mqtt_text.set_style_text_font(_font(12), 0)
     _lbl_mqtt_text.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_mqtt_text.set_width(160)
     _lbl_mqtt_text.set_pos(160, 32)
@@ -261,7 +353,7 @@ def init():
     _lbl_ble_icon = lv.label(_sbar)
     _lbl_ble_icon.set_text(lv.SYMBOL.BLUETOOTH)
     _lbl_ble_icon.set_style_text_color(_color(_DIM), 0)
-    _lbl_ble_icon.set_style_text_font(lv.font_montserrat_14, 0)
+    _lbl_ble_icon.set_style_text_font(_font(14), 0)
     _lbl_ble_icon.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_ble_icon.set_width(160)
     _lbl_ble_icon.set_pos(320, 10)
@@ -269,15 +361,11 @@ def init():
     _lbl_ble_text = lv.label(_sbar)
     _lbl_ble_text.set_text("Scan")
     _lbl_ble_text.set_style_text_color(_color(_DIM), 0)
-    _lbl_ble_text.set_style_text_font(lv.font_montserrat_12, 0)
+    _lbl_ble_text.set_style_text_font(_font(12), 0)
     _lbl_ble_text.set_style_text_align(lv.TEXT_ALIGN.CENTER, 0)
     _lbl_ble_text.set_width(160)
     _lbl_ble_text.set_pos(320, 32)
 
-    _initialised = True
-    _set_state(STARTUP)
-    print("UI initialised (STARTUP)")
-
 
 # ─── Screen renderers ─────────────────────────────────────────────────────────
 
@@ -285,53 +373,38 @@ def _show_startup():
     """Show connecting screen with sub-text."""
     if not _initialised:
         return
-    import lvgl as lv
-    # Show status + sub, hide name/weight/exporters
-    _lbl_status.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_startup_sub.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_name.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_weight.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_exporters.add_flag(lv.obj.FLAG.HIDDEN)
-
-    _lbl_status.set_text("Connecting...")
-    _lbl_status.set_style_text_color(_color(_INDIGO), 0)
-
     if _wifi_connected and not _mqtt_connected:
-        _lbl_startup_sub.set_text("MQTT: connecting...")
+        sub = "MQTT: connecting..."
     elif not _wifi_connected:
-        _lbl_startup_sub.set_text("WiFi: connecting...")
+        sub = "WiFi: connecting..."
     else:
-        _lbl_startup_sub.set_text("")
+        sub = ""
+    # Show status + sub, hide name/weight/exporters
+    _apply(_content(True, True, False) + [
+        (_lbl_status, PROP_TEXT, "Connecting..."),
+        (_lbl_status, PROP_TEXT_COLOR, _INDIGO),
+        (_lbl_startup_sub, PROP_TEXT, sub),
+    ])
 
 
 def _show_idle():
     """Show idle screen — just big 'Idle' text."""
     if not _initialised:
         return
-    import lvgl as lv
-    _lbl_status.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_startup_sub.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_name.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_weight.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_exporters.add_flag(lv.obj.FLAG.HIDDEN)
-
-    _lbl_status.set_text("Idle")
-    _lbl_status.set_style_text_color(_color(_MUTED), 0)
+    _apply(_content(True, False, False) + [
+        (_lbl_status, PROP_TEXT, "Idle"),
+        (_lbl_status, PROP_TEXT_COLOR, _MUTED),
+    ])
 
 
 def _show_scale_detected():
     """Show 'Reading in progress...' while waiting for data."""
     if not _initialised:
         return
-    import lvgl as lv
-    _lbl_status.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_startup_sub.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_name.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_weight.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_exporters.add_flag(lv.obj.FLAG.HIDDEN)
-
-    _lbl_status.set_text("Reading in\nprogress...")
-    _lbl_status.set_style_text_color(_color(_INDIGO), 0)
+    _apply(_content(True, False, False) + [
+        (_lbl_status, PROP_TEXT, "Reading in\nprogress..."),
+        (_lbl_status, PROP_TEXT_COLOR, _INDIGO),
+    ])
 
 
 def _show_reading(name, weight, exporters):
@@ -339,20 +412,15 @@ def _show_reading(name, weight, exporters):
     if not _initialised:
         return
     import lvgl as lv
-    _lbl_status.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_startup_sub.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_name.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_weight.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_exporters.remove_flag(lv.obj.FLAG.HIDDEN)
-
-    _lbl_name.set_text(name)
-    _lbl_weight.set_text(f"{weight:.1f} kg")
-
     lines = []
     for exp_name in exporters:
         lines.append(lv.SYMBOL.REFRESH + "  " + exp_name)
-    _lbl_exporters.set_text("\n".join(lines))
-    _lbl_exporters.set_style_text_color(_color(_SLATE_400), 0)
+    _apply(_content(False, False, True) + [
+        (_lbl_name, PROP_TEXT, name),
+        (_lbl_exporters, PROP_TEXT, "\n".join(lines)),
+        (_lbl_exporters, PROP_TEXT_COLOR, _SLATE_400),
+    ])
+    _set_weight(weight)
 
 
 def _show_result(name, weight, exports):
@@ -360,15 +428,6 @@ def _show_result(name, weight, exports):
     if not _initialised:
         return
     import lvgl as lv
-    _lbl_status.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_startup_sub.add_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_name.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_weight.remove_flag(lv.obj.FLAG.HIDDEN)
-    _lbl_exporters.remove_flag(lv.obj.FLAG.HIDDEN)
-
-    _lbl_name.set_text(name)
-    _lbl_weight.set_text(f"{weight:.1f} kg")
-
     # Build colored exporter lines — LVGL recoloring
     lines = []
     for exp in exports:
@@ -377,11 +436,16 @@ def _show_result(name, weight, exports):
         else:
             lines.append("#F87171 " + lv.SYMBOL.CLOSE + "  " + exp["name"] + "#")
     _lbl_exporters.set_recolor(True)
-    _lbl_exporters.set_text("\n".join(lines))
+    _apply(_content(False, False, True) + [
+        (_lbl_name, PROP_TEXT, name),
+        (_lbl_exporters, PROP_TEXT, "\n".join(lines)),
+    ])
+    _set_weight(weight)
 
 
 # ─── Public API ───────────────────────────────────────────────────────────────
 
+@_locked
 def on_wifi_change(connected):
     """Update WiFi indicator and startup sub-text."""
     global _wifi_connected
@@ -389,13 +453,13 @@ def on_wifi_change(connected):
         return
     _wifi_connected = connected
     c = _GREEN if connected else _RED
-    _lbl_wifi_icon.set_style_text_color(_color(c), 0)
-    _lbl_wifi_text.set_style_text_color(_color(c), 0)
+    _apply([(_lbl_wifi_icon, PROP_TEXT_COLOR, c), (_lbl_wifi_text, PROP_TEXT_COLOR, c)])
     if _state == STARTUP:
         _show_startup()
     print(f"UI: WiFi {'connected' if connected else 'disconnected'}")
 
 
+@_locked
 def on_mqtt_change(connected):
     """Update MQTT indicator. Transition STARTUP->IDLE when both connected."""
     global _mqtt_connected
@@ -403,8 +467,7 @@ def on_mqtt_change(connected):
         return
     _mqtt_connected = connected
     c = _INDIGO if connected else _RED
-    _lbl_mqtt_icon.set_style_text_color(_color(c), 0)
-    _lbl_mqtt_text.set_style_text_color(_color(c), 0)
+    _apply([(_lbl_mqtt_icon, PROP_TEXT_COLOR, c), (_lbl_mqtt_text, PROP_TEXT_COLOR, c)])
     if _state == STARTUP:
         if _wifi_connected and _mqtt_connected:
             _set_state(IDLE)
@@ -416,26 +479,27 @@ def on_mqtt_change(connected):
     print(f"UI: MQTT {'connected' if connected else 'disconnected'}")
 
 
+@_locked
 def on_scan_tick(count=0):
     """Flash BLE scan indicator sky-blue."""
     global _scan_flash_time
     if not board.HAS_DISPLAY or not _initialised:
         return
     _scan_flash_time = time.ticks_ms()
-    _lbl_ble_icon.set_style_text_color(_color(_SKY), 0)
-    _lbl_ble_text.set_style_text_color(_color(_SKY), 0)
+    _apply([(_lbl_ble_icon, PROP_TEXT_COLOR, _SKY), (_lbl_ble_text, PROP_TEXT_COLOR, _SKY)])
 
 
+@_locked
 def on_publish_tick():
     """Flash MQTT indicator bright on publish."""
     global _pub_flash_time
     if not board.HAS_DISPLAY or not _initialised:
         return
     _pub_flash_time = time.ticks_ms()
-    _lbl_mqtt_icon.set_style_text_color(_color(_WHITE), 0)
-    _lbl_mqtt_text.set_style_text_color(_color(_WHITE), 0)
+    _apply([(_lbl_mqtt_icon, PROP_TEXT_COLOR, _WHITE), (_lbl_mqtt_text, PROP_TEXT_COLOR, _WHITE)])
 
 
+@_locked
 def on_scale_detected(mac):
     """Transition to SCALE_DETECTED. Header scale icon bright amber."""
     if not board.HAS_DISPLAY or not _initialised:
@@ -443,10 +507,11 @@ def on_scale_detected(mac):
     if _state in (IDLE, RESULT):
         _set_state(SCALE_DETECTED)
         _show_scale_detected()
-        _lbl_hdr_scale.set_style_text_color(_color(_AMBER), 0)
+        _apply([(_lbl_hdr_scale, PROP_TEXT_COLOR, _AMBER)])
         print(f"UI: scale detected ({mac})")
 
 
+@_locked
 def on_reading(slug, name, weight, impedance, exporters):
     """Show matched user + weight + exporter list (all in-progress)."""
     if not board.HAS_DISPLAY or not _initialised:
@@ -456,6 +521,7 @@ def on_reading(slug, name, weight, impedance, exporters):
     print(f"UI: reading for {name} ({weight:.1f} kg)")
 
 
+@_locked
 def on_result(slug, name, weight, exports):
     """Show final export results with success/failure icons."""
     if not board.HAS_DISPLAY or not _initialised:
@@ -463,10 +529,11 @@ def on_result(slug, name, weight, exports):
     _set_state(RESULT)
     _show_result(name, weight, exports)
     # Dim the scale icon back
-    _lbl_hdr_scale.set_style_text_color(_color(_DIM), 0)
+    _apply([(_lbl_hdr_scale, PROP_TEXT_COLOR, _DIM)])
     print(f"UI: result for {name}")
 
 
+@_locked
 def on_config_update(users):
     """Store user list from config topic, update idle screen."""
     global _users
@@ -477,26 +544,22 @@ def on_config_update(users):
         _update_users_label()
 
 
+@_locked
 def on_scale_macs_update(has_macs):
     """Show/hide scale icon in header based on whether MACs are registered."""
     if not board.HAS_DISPLAY or not _initialised:
         return
-    import lvgl as lv
-    if has_macs:
-        _lbl_hdr_scale.remove_flag(lv.obj.FLAG.HIDDEN)
-    else:
-        _lbl_hdr_scale.add_flag(lv.obj.FLAG.HIDDEN)
+    _apply([(_lbl_hdr_scale, PROP_HIDDEN, not has_macs)])
 
 
 def _update_users_label():
     """Update the users count label."""
     n = len(_users)
-    if n > 0:
-        _lbl_users.set_text(f"{n} user{'s' if n != 1 else ''}")
-    else:
-        _lbl_users.set_text("")
+    text = f"{n} user{'s' if n != 1 else ''}" if n > 0 else ""
+    _apply([(_lbl_users, PROP_TEXT, text)])
 
 
+@_locked
 def check_timeout():
     """Handle flash fades, state timeouts, and tick LVGL. Call every loop iteration."""
     global _scan_flash_time, _pub_flash_time
@@ -508,15 +571,13 @@ def check_timeout():
 
     # Fade BLE scan flash
     if _scan_flash_time and time.ticks_diff(now, _scan_flash_time) > _FLASH_MS:
-        _lbl_ble_icon.set_style_text_color(_color(_DIM), 0)
-        _lbl_ble_text.set_style_text_color(_color(_DIM), 0)
+        _apply([(_lbl_ble_icon, PROP_TEXT_COLOR, _DIM), (_lbl_ble_text, PROP_TEXT_COLOR, _DIM)])
         _scan_flash_time = 0
 
     # Fade MQTT publish flash — restore to current connection color
     if _pub_flash_time and time.ticks_diff(now, _pub_flash_time) > _FLASH_MS:
         c = _INDIGO if _mqtt_connected else _RED
-        _lbl_mqtt_icon.set_style_text_color(_color(c), 0)
-        _lbl_mqtt_text.set_style_text_color(_color(c), 0)
+        _apply([(_lbl_mqtt_icon, PROP_TEXT_COLOR, c), (_lbl_mqtt_text, PROP_TEXT_COLOR, c)])
         _pub_flash_time = 0
 
     # State timeouts
@@ -526,13 +587,15 @@ def check_timeout():
         print("UI: scale detected timeout")
         _set_state(IDLE)
         _show_idle()
-        _lbl_hdr_scale.set_style_text_color(_color(_DIM), 0)
+        _apply([(_lbl_hdr_scale, PROP_TEXT_COLOR, _DIM)])
 
     elif _state == RESULT and elapsed > _RESULT_TIMEOUT_MS:
         _set_state(IDLE)
         _show_idle()
 
     # Process pending LVGL renders (tick is handled by C esp_timer)
+    if _disp is not None:
+        return  # rendered by the driver's LVGL task
     try:
         lv.task_handler()
     except Exception:
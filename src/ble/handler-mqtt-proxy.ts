@@ -69,7 +69,7 @@ const COMMAND_TIMEOUT_MS = 30_000;
 
 // ─── Types ────────────────────────────────────────────────────────────────────
 
-interface ScanResultEntry {
+export interface ScanResultEntry {
   address: string;
   name: string;
   rssi: number;
@@ -79,6 +79,75 @@ interface ScanResultEntry {
   manufacturer_data?: string | null;
 }
 
+// ─── Packed scan results ──────────────────────────────────────────────────────
+
+// Binary scan/results encoding produced by the ESP32's native device table
+// (drivers/ble_scan/ble_scan.c). All integers little-endian:
+//   header  "BS" version:u8 reserved:u8 count:u16
+//   device  addr[6] addr_type:u8 rssi:i8 uuid_count:u8 name_len:u8 mfr_len:u8
+//           uuids:u16[uuid_count] name[name_len] mfr[mfr_len]
+// mfr is company ID + data, mfr_len 0 means none.
+const PACKED_MAGIC = 0x5342; // "BS" read as u16le
+const PACKED_VERSION = 1;
+const PACKED_HEADER_LEN = 6;
+const PACKED_DEVICE_LEN = 11;
+
+function decodePackedScanResults(buf: Buffer): ScanResultEntry[] {
+  if (buf.length < PACKED_HEADER_LEN) throw new Error('packed scan results: short header');
+  const version = buf[2];
+  if (version !== PACKED_VERSION) {
+    throw new Error(`packed scan results: unsupported version ${version}`);
+  }
+  const count = buf.readUInt16LE(4);
+  const entries: ScanResultEntry[] = [];
+  let off = PACKED_HEADER_LEN;
+  for (let i = 0; i < count; i++) {
+    if (off + PACKED_DEVICE_LEN > buf.length) {
+      throw new Error(`packed scan results: truncated at device ${i}`);
+    }
+    const addr = buf.subarray(off, off + 6);
+    const addrType = buf[off + 6];
+    const rssi = buf.readInt8(off + 7);
+    const uuidCount = buf[off + 8];
+    const nameLen = buf[off + 9];
+    const mfrLen = buf[off + 10];
+    off += PACKED_DEVICE_LEN;
+    if (off + 2 * uuidCount + nameLen + mfrLen > buf.length) {
+      throw new Error(`packed scan results: truncated at device ${i}`);
+    }
+
+    const services: string[] = [];
+    for (let k = 0; k < uuidCount; k++, off += 2) {
+      services.push(buf.readUInt16LE(off).toString(16).padStart(4, '0'));
+    }
+    const name = buf.toString('utf8', off, off + nameLen);
+    off += nameLen;
+
+    const entry: ScanResultEntry = {
+      address: [...addr].map((b) => b.toString(16).padStart(2, '0').toUpperCase()).join(':'),
+      name,
+      rssi,
+      services,
+      addr_type: addrType,
+    };
+    if (mfrLen >= 2) {
+      entry.manufacturer_id = buf.readUInt16LE(off);
+      entry.manufacturer_data = buf.toString('hex', off + 2, off + mfrLen);
+    }
+    off += mfrLen;
+    entries.push(entry);
+  }
+  return entries;
+}
+
+/** Decode a scan/results payload, JSON or the packed binary encoding. */
+export function decodeScanResults(payload: Buffer): ScanResultEntry[] {
+  if (payload.length >= 2 && payload.readUInt16LE(0) === PACKED_MAGIC) {
+    return decodePackedScanResults(payload);
+  }
+  return JSON.parse(payload.toString()) as ScanResultEntry[];
+}
+
 /** Build BleDeviceInfo from a scan result entry, including manufacturer data. */
 function toBleDeviceInfo(entry: ScanResultEntry): BleDeviceInfo {
   const info: BleDeviceInfo = {
@@ -102,6 +171,8 @@ function topics(prefix: string, deviceId: string) {
     base,
     status: `${base}/status`,
     scanResults: `${base}/scan/results`,
+    scanFormat: `${base}/scan/format`,
+    capabilities: `${base}/capabilities`,
     config: `${base}/config`,
     beep: `${base}/beep`,
     // GATT proxy topics
@@ -274,7 +345,7 @@ async function mqttScan(
   const handler = (topic: string, payload: Buffer) => {
     if (topic === t.scanResults) {
       try {
-        resolveResults(JSON.parse(payload.toString()) as ScanResultEntry[]);
+        resolveResults(decodeScanResults(payload));
       } catch (err) {
         rejectResults(new Error(`ESP32 sent invalid scan results: ${err}`));
       }
@@ -586,7 +657,9 @@ export class ReadingWatcher {
       await client.subscribeAsync(t.scanResults, { qos: 1 });
       // Subscribe to status for logging only
       await client.subscribeAsync(t.status);
-      this._subscribedTopics = [t.scanResults, t.status];
+      // The ESP32 announces its scan/results encodings (retained) on connect
+      await client.subscribeAsync(t.capabilities);
+      this._subscribedTopics = [t.scanResults, t.status, t.capabilities];
       bleLog.info('ReadingWatcher started — listening for scan results');
     } catch (err) {
       this.started = false;
@@ -599,10 +672,14 @@ export class ReadingWatcher {
         bleLog.info(`ESP32 status: ${payload.toString()}`);
         return;
       }
+      if (topic === t.capabilities) {
+        this.negotiateScanFormat(client, t, payload);
+        return;
+      }
       if (topic !== t.scanResults) return;
 
       try {
-        const results: ScanResultEntry[] = JSON.parse(payload.toString());
+        const results = decodeScanResults(payload);
         const candidates = this.targetMac
           ? results.filter((e) => e.address.toLowerCase() === this.targetMac!.toLowerCase())
           : results;
@@ -745,6 +822,31 @@ export class ReadingWatcher {
     }
   }
 
+  /**
+   * Answer the ESP32's capabilities announcement with the scan/results
+   * encoding to use (retained). JSON unless `scan_format: packed` is configured
+   * and the firmware can produce it; either encoding is decoded regardless.
+   */
+  private negotiateScanFormat(
+    client: MqttClient,
+    t: ReturnType<typeof topics>,
+    payload: Buffer,
+  ): void {
+    let formats: string[] = [];
+    try {
+      const caps = JSON.parse(payload.toString()) as { scan_formats?: unknown };
+      if (Array.isArray(caps.scan_formats)) formats = caps.scan_formats.map(String);
+    } catch {
+      bleLog.debug(`Ignoring malformed ESP32 capabilities: ${payload.toString()}`);
+    }
+    const format =
+      this.config.scan_format === 'packed' && formats.includes('packed') ? 'packed' : 'json';
+    bleLog.info(`ESP32 scan results format: ${format}`);
+    client.publishAsync(t.scanFormat, format, { retain: true }).catch((err: Error) => {
+      bleLog.warn(`Failed to publish scan format: ${err.message}`);
+    });
+  }
+
   private pruneDedup(now: number): void {
     for (const [key, ts] of this.dedup) {
       if (now - ts >= DEDUP_WINDOW_MS) this.dedup.delete(key);
@@ -19,6 +19,7 @@ export const MqttProxySchema = z.object({
   username: z.string().optional().nullable(),
   password: z.string().optional().nullable(),
   topic_prefix: z.string().default('ble-proxy'),
+  scan_format: z.enum(['json', 'packed']).optional(),
 });
 
 export const BleSchema = z
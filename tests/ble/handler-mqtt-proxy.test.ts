@@ -163,6 +163,7 @@ const {
   setDisplayUsers,
   AsyncQueue,
   ReadingWatcher,
+  decodeScanResults,
   _resetProxyState,
 } = await import('../../src/ble/handler-mqtt-proxy.js');
 
@@ -175,6 +176,44 @@ function mfrHex(weightCentkg: number): string {
   return buf.toString('hex');
 }
 
+/** Encode entries in the ESP32's packed scan/results format. */
+function packScanResults(
+  entries: Array<{
+    address: string;
+    name: string;
+    rssi: number;
+    services: string[];
+    addr_type?: number;
+    manufacturer_id?: number;
+    manufacturer_data?: string;
+  }>,
+  version = 1,
+): Buffer {
+  const header = Buffer.from([0x42, 0x53, version, 0, entries.length & 0xff, entries.length >> 8]);
+  const parts = [header];
+  for (const e of entries) {
+    const name = Buffer.from(e.name, 'utf8');
+    const mfr =
+      e.manufacturer_id != null
+        ? Buffer.concat([
+            Buffer.from([e.manufacturer_id & 0xff, e.manufacturer_id >> 8]),
+            Buffer.from(e.manufacturer_data ?? '', 'hex'),
+          ])
+        : Buffer.alloc(0);
+    const fixed = Buffer.alloc(11);
+    Buffer.from(e.address.replace(/:/g, ''), 'hex').copy(fixed, 0);
+    fixed[6] = e.addr_type ?? 0;
+    fixed.writeInt8(e.rssi, 7);
+    fixed[8] = e.services.length;
+    fixed[9] = name.length;
+    fixed[10] = mfr.length;
+    const uuids = Buffer.alloc(2 * e.services.length);
+    e.services.forEach((u, i) => uuids.writeUInt16LE(parseInt(u, 16), 2 * i));
+    parts.push(fixed, uuids, name, mfr);
+  }
+  return Buffer.concat(parts);
+}
+
 /**
  * Wire up the mock client to simulate ESP32 online + scan results with
  * broadcast manufacturer data.
@@ -745,6 +784,66 @@ describe('handler-mqtt-proxy', () => {
     });
   });
 
+  describe('decodeScanResults', () => {
+    it('decodes the packed encoding into JSON-shaped entries', () => {
+      const entries = [
+        {
+          address: 'AA:BB:CC:DD:EE:FF',
+          name: '',
+          rssi: -50,
+          services: [],
+          addr_type: 1,
+          manufacturer_id: 0xffff,
+          manufacturer_data: mfrHex(7550),
+        },
+        {
+          address: '11:22:33:44:55:66',
+          name: 'Scäle',
+          rssi: -80,
+          services: ['181d', '181b'],
+          addr_type: 0,
+        },
+      ];
+
+      expect(decodeScanResults(packScanResults(entries))).toEqual(entries);
+    });
+
+    it('keeps empty manufacturer data when only a company ID was advertised', () => {
+      const [entry] = decodeScanResults(
+        packScanResults([
+          {
+            address: 'AA:BB:CC:DD:EE:FF',
+            name: 'X',
+            rssi: -60,
+            services: [],
+            manufacturer_id: 0x0157,
+          },
+        ]),
+      );
+      expect(entry.manufacturer_id).toBe(0x0157);
+      expect(entry.manufacturer_data).toBe('');
+    });
+
+    it('still parses JSON payloads', () => {
+      const json = [{ address: 'AA:BB:CC:DD:EE:FF', name: 'Scale', rssi: -40, services: [] }];
+      expect(decodeScanResults(Buffer.from(JSON.stringify(json)))).toEqual(json);
+    });
+
+    it('rejects truncated packed payloads and unknown versions', () => {
+      const packed = packScanResults([
+        { address: 'AA:BB:CC:DD:EE:FF', name: 'Scale', rssi: -40, services: ['181d'] },
+      ]);
+      expect(() => decodeScanResults(packed.subarray(0, packed.length - 1))).toThrow(
+        'truncated',
+      );
+      expect(() =>
+        decodeScanResults(
+          packScanResults([{ address: 'AA:BB:CC:DD:EE:FF', name: '', rssi: 0, services: [] }], 2),
+        ),
+      ).toThrow('unsupported version 2');
+    });
+  });
+
   describe('AsyncQueue', () => {
     it('returns buffered items in FIFO order', async () => {
       const q = new AsyncQueue<number>();
@@ -987,6 +1086,73 @@ describe('handler-mqtt-proxy', () => {
     });
   });
 
+  describe('ReadingWatcher scan format', () => {
+    it('pushes readings from packed scan results', async () => {
+      const watcher = new ReadingWatcher(MQTT_PROXY_CONFIG, [createBroadcastAdapter()]);
+      await watcher.start();
+
+      mockClient._simulateMessage(
+        `${PREFIX}/scan/results`,
+        packScanResults([
+          {
+            address: 'AA:BB:CC:DD:EE:FF',
+            name: '',
+            rssi: -50,
+            services: [],
+            manufacturer_id: 0xffff,
+            manufacturer_data: mfrHex(7550),
+          },
+        ]),
+      );
+
+      const raw = await watcher.nextReading();
+      expect(raw.reading.weight).toBe(75.5);
+    });
+
+    it('requests packed results when configured and supported', async () => {
+      const watcher = new ReadingWatcher({ ...MQTT_PROXY_CONFIG, scan_format: 'packed' }, [
+        createBroadcastAdapter(),
+      ]);
+      await watcher.start();
+      expect(mockClient.subscribeAsync).toHaveBeenCalledWith(`${PREFIX}/capabilities`);
+
+      mockClient._simulateMessage(
+        `${PREFIX}/capabilities`,
+        JSON.stringify({ scan_formats: ['json', 'packed'] }),
+      );
+
+      expect(mockClient.publishAsync).toHaveBeenCalledWith(`${PREFIX}/scan/format`, 'packed', {
+        retain: true,
+      });
+    });
+
+    it('stays on JSON by default or when the firmware lacks packed support', async () => {
+      const watcher = new ReadingWatcher(MQTT_PROXY_CONFIG, [createBroadcastAdapter()]);
+      await watcher.start();
+      mockClient._simulateMessage(
+        `${PREFIX}/capabilities`,
+        JSON.stringify({ scan_formats: ['json', 'packed'] }),
+      );
+      expect(mockClient.publishAsync).toHaveBeenLastCalledWith(`${PREFIX}/scan/format`, 'json', {
+        retain: true,
+      });
+      await watcher.stop();
+
+      _resetProxyState();
+      const packedWatcher = new ReadingWatcher({ ...MQTT_PROXY_CONFIG, scan_format: 'packed' }, [
+        createBroadcastAdapter(),
+      ]);
+      await packedWatcher.start();
+      mockClient._simulateMessage(
+        `${PREFIX}/capabilities`,
+        JSON.stringify({ scan_formats: ['json'] }),
+      );
+      expect(mockClient.publishAsync).toHaveBeenLastCalledWith(`${PREFIX}/scan/format`, 'json', {
+        retain: true,
+      });
+    });
+  });
+
   describe('GATT proxy', () => {
     /** Wire GATT flow: online → scan (GATT device) → connected → notification.
      *  Connected response is triggered by publishAsync(connect), not subscribeAsync,